@@ -0,0 +1,63 @@
+#ifndef ALGORITHMS_H
+#define ALGORITHMS_H
+
+#include "arraylist.h"
+#include "linearlist.h"
+
+#ifdef __cplusplus
+# include <algorithm>
+# include <cstddef>
+# include <functional>
+# include <type_traits>
+# include <utility>
+#endif
+// 对任意种类线性表通用的算法。参数是 LinearList<List, T>，
+// 实例化时 List 已知，对表的调用都是直接调用，可以内联。
+// 遍历都通过表的迭代器进行，链式的表上也是 O(n)，不按下标逐个 at()
+
+// 第一个等于 value 的元素的下标，没有时返回 size()
+template <typename List, typename T>
+size_t find(LinearList<List, T> const &list,
+            typename LinearList<List, T>::value_type const &value) {
+    size_t index = 0;
+    for (T const &element: list.derived()) {
+        if (element == value) {
+            break;
+        }
+        index++;
+    }
+    return index;
+}
+
+// 从 init 开始依次用 op 合并所有元素，默认为求和
+template <typename List, typename T, typename U,
+          typename BinaryOp = std::plus<>>
+U accumulate(LinearList<List, T> const &list, U init,
+             BinaryOp op = BinaryOp()) {
+    for (T const &element: list.derived()) {
+        init = op(std::move(init), element);
+    }
+    return init;
+}
+
+// 按 comp 升序排序，不保证稳定。
+// 迭代器是指针(连续存储)时原地排序；否则先把元素取到数组中排好，再按顺序写回
+template <typename List, typename T, typename Compare = std::less<T>>
+void sort(LinearList<List, T> &list, Compare comp = Compare()) {
+    List &self = list.derived();
+    if constexpr (std::is_pointer<decltype(self.begin())>::value) {
+        std::sort(self.begin(), self.end(), comp);
+    } else {
+        ArrayList<T> buffer(self.size());
+        for (T const &element: self) {
+            buffer.push_back(element);
+        }
+        std::sort(buffer.begin(), buffer.end(), comp);
+        T *source = buffer.begin();
+        for (T &element: self) {
+            element = std::move(*source++);
+        }
+    }
+}
+
+#endif // !ALGORITHMS_H
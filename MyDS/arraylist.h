@@ -11,7 +11,7 @@
 
 #endif
 template <typename T>
-class ArrayList : public LinearList<T> {
+class ArrayList : public LinearList<ArrayList<T>, T> {
 public:
     ArrayList() : ArrayList(INITIAL_CAPACITY) {}
 
@@ -81,35 +81,35 @@ public:
         return *this;
     }
 
-    ~ArrayList() override {
+    ~ArrayList() {
         if (elements != nullptr) {
             delete[] elements;
         }
     }
 
-    bool empty() const noexcept override {
+    bool empty() const noexcept {
         return _size == 0;
     }
 
-    size_t size() const noexcept override {
+    size_t size() const noexcept {
         return _size;
     }
 
-    void clear() noexcept override {
+    void clear() noexcept {
         _size = 0;
     }
 
-    T &at(size_t index) override {
+    T &at(size_t index) {
         this->check_index(index);
         return elements[index];
     }
 
-    T const &at(size_t index) const override {
+    T const &at(size_t index) const {
         this->check_index(index);
         return elements[index];
     }
 
-    void insert(size_t index, T const &value) override {
+    void insert(size_t index, T const &value) {
         this->check_index(index, true);
         if (_size == _capacity) {
             size_t new_capacity = (_capacity == 0) ? 1 : 2 * _capacity;
@@ -122,12 +122,12 @@ public:
         ++_size;
     }
 
-    void replace(size_t index, T const &value) override {
+    void replace(size_t index, T const &value) {
         this->check_index(index);
         elements[index] = value;
     }
 
-    void erase(size_t index) override {
+    void erase(size_t index) {
         this->check_index(index);
         for (size_t i = index; i < _size - 1; i++) {
             elements[i] = elements[i + 1];
@@ -144,31 +144,31 @@ public:
         erase(index);
     }
 
-    void push_back(T const &value) override {
+    void push_back(T const &value) {
         insert(_size, value);
     }
 
-    void pop_back() override {
+    void pop_back() {
         this->check_empty();
         --_size;
     }
 
-    T &front() override {
+    T &front() {
         this->check_empty();
         return elements[0];
     }
 
-    T const &front() const override {
+    T const &front() const {
         this->check_empty();
         return elements[0];
     }
 
-    T &back() override {
+    T &back() {
         this->check_empty();
         return elements[_size - 1];
     }
 
-    T const &back() const override {
+    T const &back() const {
         this->check_empty();
         return elements[_size - 1];
     }
@@ -214,13 +214,20 @@ public:
         return os;
     }
 
+    // 下标访问不做检查，供 Heap、Graph 等的内层循环使用；
+    // 定义 MYDS_CHECKED 时与 at() 一样检查下标，用于调试。
+    // 需要总是检查时用 at()
     T &operator[](size_t index) {
+#ifdef MYDS_CHECKED
         this->check_index(index);
+#endif
         return elements[index];
     }
 
     T const &operator[](size_t index) const {
+#ifdef MYDS_CHECKED
         this->check_index(index);
+#endif
         return elements[index];
     }
 
@@ -0,0 +1,95 @@
+// ArrayList 下标检查对 Heap 和 Graph::dijkstra 的影响
+// 同一源文件编译两次：container_bench 不检查下标，
+// container_bench_checked 定义 MYDS_CHECKED，operator[] 每次都检查。
+// 比较两者的输出即可看出检查的开销
+#include "graph.h"
+#include "heap.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+struct Random {
+    uint64_t state;
+
+    explicit Random(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+// n 个随机数全部入堆再全部出堆，返回秒数
+double bench_heap(size_t n) {
+    Random random(1);
+    Heap<uint32_t> heap; // comp 为 std::less，堆顶是最小值
+    auto start = Clock::now();
+    for (size_t i = 0; i < n; i++) {
+        heap.push(static_cast<uint32_t>(random.next()));
+    }
+    uint32_t last = 0;
+    bool ordered = true;
+    while (!heap.empty()) {
+        ordered = ordered && !(heap.top() < last);
+        last = heap.top();
+        heap.pop();
+    }
+    if (!ordered) {
+        std::cerr << "heap order violated\n";
+    }
+    return seconds_since(start);
+}
+
+// vertices 个顶点、每个顶点 degree 条随机边的无向图上求一次单源最短路
+double bench_dijkstra(size_t vertices, size_t degree) {
+    Random random(2);
+    Graph<long long> graph;
+    for (size_t i = 0; i < vertices; i++) {
+        graph.add_vertex();
+    }
+    for (size_t i = 0; i < vertices; i++) {
+        for (size_t k = 0; k < degree; k++) {
+            size_t to = random.next() % vertices;
+            graph.add_edge(i, to, static_cast<long long>(random.next() % 1000));
+        }
+    }
+    auto start = Clock::now();
+    auto result = graph.dijkstra(0);
+    double seconds = seconds_since(start);
+    if (result.first.size() != vertices) {
+        std::cerr << "unexpected result\n";
+    }
+    return seconds;
+}
+
+} // namespace
+
+int main() {
+#ifdef MYDS_CHECKED
+    std::cout << "operator[]: checked\n";
+#else
+    std::cout << "operator[]: unchecked\n";
+#endif
+    std::cout << std::fixed << std::setprecision(3);
+    for (size_t n = 100000; n <= 1000000; n *= 10) {
+        std::cout << "Heap push/pop   n = " << std::setw(8) << n << "  "
+                  << bench_heap(n) << " s\n";
+    }
+    for (size_t v = 2000; v <= 20000; v *= 10) {
+        std::cout << "Graph::dijkstra V = " << std::setw(8) << v << "  "
+                  << bench_dijkstra(v, 8) << " s\n";
+    }
+    return 0;
+}
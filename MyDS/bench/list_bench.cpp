@@ -0,0 +1,95 @@
+// 跳表与双向链表按位置操作的性能比较
+// 对 10^5、10^6、10^7 个元素分别测量：顺序追加、随机按下标读、
+// 随机位置插入后删除。链表每次按下标操作要走 O(n) 步，
+// 因此对它只做较少次数的随机操作，按每次操作的平均耗时比较
+#include "linkedlist.h"
+#include "skiplist.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// 简单的 xorshift 随机数，保证两种表用相同的下标序列
+struct Random {
+    uint64_t state;
+
+    explicit Random(uint64_t seed) : state(seed) {}
+
+    size_t below(size_t n) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<size_t>(state % n);
+    }
+};
+
+struct Result {
+    double build;  // 顺序追加全部元素的总耗时(秒)
+    double at;     // 每次随机读的平均耗时(纳秒)
+    double update; // 每次随机插入加删除的平均耗时(纳秒)
+};
+
+template <typename List>
+Result measure(size_t n, size_t ops) {
+    Result result;
+    List list;
+    auto start = Clock::now();
+    for (size_t i = 0; i < n; i++) {
+        list.push_back(static_cast<int>(i));
+    }
+    result.build = seconds_since(start);
+
+    Random random(42);
+    long long checksum = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < ops; i++) {
+        checksum += list.at(random.below(n));
+    }
+    result.at = seconds_since(start) * 1e9 / ops;
+
+    start = Clock::now();
+    for (size_t i = 0; i < ops; i++) {
+        size_t index = random.below(n);
+        list.insert(index, -1);
+        list.erase(random.below(n + 1));
+    }
+    result.update = seconds_since(start) * 1e9 / ops;
+
+    if (list.size() != n || checksum < 0) {
+        std::cerr << "unexpected result\n";
+    }
+    return result;
+}
+
+void print_row(char const *name, size_t n, Result const &result) {
+    std::cout << std::left << std::setw(12) << name << std::right
+              << std::setw(10) << n << std::fixed << std::setprecision(3)
+              << std::setw(12) << result.build << std::setprecision(0)
+              << std::setw(14) << result.at << std::setw(14) << result.update
+              << '\n';
+}
+
+} // namespace
+
+int main() {
+    std::cout << std::left << std::setw(12) << "list" << std::right
+              << std::setw(10) << "n" << std::setw(12) << "build(s)"
+              << std::setw(14) << "at(ns)" << std::setw(14)
+              << "insert+erase" << '\n';
+    for (size_t n = 100000; n <= 10000000; n *= 10) {
+        // 链表的随机操作总共约走 10^8 步，几十秒内可以跑完
+        size_t linked_ops = 100000000 / n;
+        print_row("SkipList", n, measure<SkipList<int>>(n, 1000000));
+        print_row("LinkedList", n, measure<LinkedList<int>>(n, linked_ops));
+    }
+    return 0;
+}
@@ -1,12 +1,15 @@
 #ifndef BINARY_TREE_H
 #define BINARY_TREE_H
 #include "circularqueue.h"
+#include "nodepool.h"
 #ifdef __cplusplus
 # include <algorithm>
 # include <cstddef>
 # include <ostream>
+# include <type_traits>
 #endif
-template <typename T>
+// Allocator 为结点分配策略，见 nodepool.h
+template <typename T, template <typename> class Allocator = NewAllocator>
 class BinaryTree {
 private:
     struct Node {
@@ -24,6 +27,7 @@ private:
 
     Node *root;
     size_t size_;
+    Allocator<Node> nodes_;
 
     size_t height(Node const *node) const noexcept {
         if (node == nullptr) {
@@ -38,39 +42,50 @@ private:
         if (node == nullptr) {
             return nullptr;
         }
-        return new Node(node->data, copy_tree(node->left),
-                        copy_tree(node->right));
+        return nodes_.create(node->data, copy_tree(node->left),
+                             copy_tree(node->right));
     }
 
     void destroy_tree(Node *node) noexcept {
+        // 结点可平凡析构时整块释放内存池，不必逐个释放
+        if (Allocator<Node>::can_reset &&
+            std::is_trivially_destructible<Node>::value) {
+            nodes_.reset();
+            return;
+        }
         if (node != nullptr) {
             destroy_tree(node->left);
             destroy_tree(node->right);
-            delete node;
+            nodes_.destroy(node);
         }
     }
 
 public:
     BinaryTree() : root(nullptr), size_(0) {}
 
-    BinaryTree(BinaryTree<T> const &other)
-        : root(copy_tree(other.root)),
-          size_(other.size_) {}
+    // 复制在函数体中进行，此时 nodes_ 已构造
+    BinaryTree(BinaryTree const &other) : root(nullptr), size_(0) {
+        root = copy_tree(other.root);
+        size_ = other.size_;
+    }
 
-    BinaryTree(BinaryTree<T> &&other) : root(other.root), size_(other.size_) {
+    BinaryTree(BinaryTree &&other)
+        : root(other.root),
+          size_(other.size_),
+          nodes_(std::move(other.nodes_)) {
         other.root = nullptr;
         other.size_ = 0;
     }
 
-    BinaryTree<T> &operator=(BinaryTree<T> const &other) {
+    BinaryTree &operator=(BinaryTree const &other) {
         if (this != &other) {
-            BinaryTree<T> temp(other);
+            BinaryTree temp(other);
             swap(temp);
         }
         return *this;
     }
 
-    BinaryTree<T> &operator=(BinaryTree<T> &&other) {
+    BinaryTree &operator=(BinaryTree &&other) {
         if (this != &other) {
             swap(other);
         }
@@ -144,7 +159,7 @@ public:
     }
 
     friend std::ostream &operator<<(std::ostream &os,
-                                    BinaryTree<T> const &tree) {
+                                    BinaryTree const &tree) {
         if (tree.empty()) {
             return os << "[]";
         }
@@ -176,9 +191,10 @@ public:
     }
 
 private:
-    void swap(BinaryTree<T> &other) noexcept {
+    void swap(BinaryTree &other) noexcept {
         std::swap(root, other.root);
         std::swap(size_, other.size_);
+        nodes_.swap(other.nodes_);
     }
 };
 
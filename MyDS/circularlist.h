@@ -2,113 +2,218 @@
 
 #define CIRCULAR_LIST_H
 #include "linearlist.h"
+#include "nodepool.h"
 #ifdef __cplusplus
 # include <ostream>
+# include <type_traits>
 #endif
-template <typename T>
-class CircularList : LinearList<T> {
+// Allocator 为结点分配策略，见 nodepool.h
+template <typename T, template <typename> class Allocator = NewAllocator>
+class CircularList : public LinearList<CircularList<T, Allocator>, T> {
     struct Node {
         T data;
         Node *next;
         Node *prev;
         Node(T const &value, Node *p = nullptr, Node *n = nullptr)
             : data(value),
-              prev(p),
-              next(n) {};
+              next(n),
+              prev(p) {};
     };
 
     Node *head_;
     size_t size_;
+    Allocator<Node> nodes_;
 
-    Node *locate(size_t index) const {
-        Node *current = head_;
-        for (size_t i = 0; i < index; i++) {
-            current = current->next;
+    // 从 node 出发向后走 k 步(k < size_)，按较短的方向走 min(k, size_ - k) 步
+    Node *walk(Node *node, size_t k) const {
+        if (k <= size_ - k) {
+            for (size_t i = 0; i < k; i++) {
+                node = node->next;
+            }
+        } else {
+            for (size_t i = k; i < size_; i++) {
+                node = node->prev;
+            }
         }
-        return current;
+        return node;
     }
 
-    void swap(CircularList<T> &other) noexcept {
+    Node *locate(size_t index) const {
+        return walk(head_, index);
+    }
+
+    void swap(CircularList &other) noexcept {
         std::swap(head_, other.head_);
         std::swap(size_, other.size_);
+        nodes_.swap(other.nodes_);
     }
 
 public:
+    // 指向某个元素的游标。元素被删除前一直有效，不受其他位置插入删除的影响
+    class Cursor {
+    public:
+        Cursor() : node(nullptr) {}
+
+        T &operator*() const {
+            return node->data;
+        }
+
+        T *operator->() const {
+            return &node->data;
+        }
+
+        // 环上的下一个、上一个元素
+        Cursor &operator++() {
+            node = node->next;
+            return *this;
+        }
+
+        Cursor &operator--() {
+            node = node->prev;
+            return *this;
+        }
+
+        bool operator==(Cursor const &other) const {
+            return node == other.node;
+        }
+
+        bool operator!=(Cursor const &other) const {
+            return node != other.node;
+        }
+
+        // 是否指向某个元素(空表上得到的游标不指向任何元素)
+        explicit operator bool() const {
+            return node != nullptr;
+        }
+
+    private:
+        friend class CircularList;
+        Node *node;
+
+        explicit Cursor(Node *node) : node(node) {}
+    };
+
+    // 从表头起绕一圈的前向迭代器，remaining 为还未访问的元素个数
+    template <typename Value>
+    class Iterator {
+    public:
+        Iterator(Node *node, size_t remaining)
+            : node(node),
+              remaining(remaining) {}
+
+        Value &operator*() const {
+            return node->data;
+        }
+
+        Value *operator->() const {
+            return &node->data;
+        }
+
+        Iterator &operator++() {
+            node = node->next;
+            remaining--;
+            return *this;
+        }
+
+        bool operator==(Iterator const &other) const {
+            return node == other.node && remaining == other.remaining;
+        }
+
+        bool operator!=(Iterator const &other) const {
+            return !(*this == other);
+        }
+
+    private:
+        Node *node;
+        size_t remaining;
+    };
+
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<T const>;
+
     CircularList() : head_(nullptr), size_(0) {}
 
-    CircularList(CircularList<T> const &other) : head_(nullptr), size_(0) {
+    CircularList(CircularList const &other) : head_(nullptr), size_(0) {
         if (!other.empty()) {
             Node *current = other.head_;
             push_back(current->data);
             current = current->next;
-            while (current->next != other.head_) {
+            while (current != other.head_) {
                 push_back(current->data);
                 current = current->next;
             }
         }
     }
 
-    CircularList(CircularList<T> &&other)
+    CircularList(CircularList &&other)
         : head_(other.head_),
-          size_(other.size_) {
+          size_(other.size_),
+          nodes_(std::move(other.nodes_)) {
         other.head_ = nullptr;
         other.size_ = 0;
     }
 
-    CircularList<T> &operator=(CircularList<T> &other) {
+    CircularList &operator=(CircularList &other) {
         if (this != &other) {
-            CircularList<T> temp(other);
+            CircularList temp(other);
             swap(temp);
         }
         return *this;
     }
 
-    CircularList<T> &operator=(CircularList<T> &&other) {
+    CircularList &operator=(CircularList &&other) {
         if (this != &other) {
             swap(other);
         }
         return *this;
     }
 
-    ~CircularList() override {
+    ~CircularList() {
         clear();
     }
 
-    bool empty() const noexcept override {
+    bool empty() const noexcept {
         return size_ == 0;
     }
 
-    size_t size() const noexcept override {
+    size_t size() const noexcept {
         return size_;
     }
 
-    void clear() noexcept override {
-        if (!empty()) {
+    void clear() noexcept {
+        if (empty()) {
+            return;
+        }
+        // 结点可平凡析构时整块释放内存池，不必逐个释放
+        if (Allocator<Node>::can_reset &&
+            std::is_trivially_destructible<Node>::value) {
+            nodes_.reset();
+        } else {
             Node *current = head_->next;
             while (current != head_) {
                 Node *temp = current;
                 current = current->next;
-                delete temp;
+                nodes_.destroy(temp);
             }
-            delete head_;
-            head_ = nullptr;
-            size_ = 0;
+            nodes_.destroy(head_);
         }
+        head_ = nullptr;
+        size_ = 0;
     }
 
-    T &at(size_t index) override {
+    T &at(size_t index) {
         this->check_index(index);
         return locate(index)->data;
     }
 
-    T const &at(size_t index) const override {
+    T const &at(size_t index) const {
         this->check_index(index);
         return locate(index)->data;
     }
 
-    void insert(size_t index, T const &value) override {
+    void insert(size_t index, T const &value) {
         this->check_index(index, true);
-        Node *new_node = new Node(value);
+        Node *new_node = nodes_.create(value);
         if (empty()) {
             new_node->prev = new_node;
             new_node->next = new_node;
@@ -126,10 +231,10 @@ public:
         size_++;
     }
 
-    void erase(size_t index) override {
+    void erase(size_t index) {
         this->check_index(index);
         if (size_ == 1) {
-            delete head_;
+            nodes_.destroy(head_);
             head_ = nullptr;
         } else {
             Node *current = locate(index);
@@ -138,54 +243,120 @@ public:
             if (current == head_) {
                 head_ = head_->next;
             }
-            delete current;
+            nodes_.destroy(current);
         }
         size_--;
     }
 
-    void push_back(T const &value) override {
+    void push_back(T const &value) {
         if (empty()) {
             insert(0, value);
         } else {
-            Node *new_node = new Node(value, head_->prev, head_);
+            Node *new_node = nodes_.create(value, head_->prev, head_);
             head_->prev->next = new_node;
             head_->prev = new_node;
             size_++;
         }
     }
 
-    void pop_back() override {
+    void pop_back() {
         this->check_empty();
         erase(size_ - 1);
     }
 
-    T &front() override {
+    T &front() {
         this->check_empty();
         return head_->data;
     }
 
-    T const &front() const override {
+    T const &front() const {
         this->check_empty();
         return head_->data;
     }
 
-    T &back() override {
+    T &back() {
         this->check_empty();
         return head_->prev->data;
     }
 
-    T const &back() const override {
+    T const &back() const {
         this->check_empty();
         return head_->prev->data;
     }
 
-    void replace(size_t index, T const &value) override {
+    void replace(size_t index, T const &value) {
         this->check_index(index);
         locate(index)->data = value;
     }
 
+    // 指向第 index 个元素的游标，空表时返回不指向元素的游标
+    Cursor cursor(size_t index = 0) {
+        if (empty()) {
+            return Cursor();
+        }
+        this->check_index(index);
+        return Cursor(locate(index));
+    }
+
+    // 从 position 向后数 k 个(环绕)元素的游标，按较短的方向走
+    Cursor advance(Cursor position, size_t k) const {
+        this->check_empty();
+        return Cursor(walk(position.node, k % size_));
+    }
+
+    // 删除 position 处的元素，返回其后一个元素的游标；删空时返回空游标
+    Cursor erase_at(Cursor position) {
+        this->check_empty();
+        Node *current = position.node;
+        Node *next = current->next;
+        if (size_ == 1) {
+            next = nullptr;
+            head_ = nullptr;
+        } else {
+            current->prev->next = next;
+            next->prev = current->prev;
+            if (current == head_) {
+                head_ = next;
+            }
+        }
+        nodes_.destroy(current);
+        size_--;
+        return Cursor(next);
+    }
+
+    // 在 position 之前插入 value，返回新元素的游标。
+    // position 是表头时新元素成为表尾；空表时 position 可以是空游标
+    Cursor insert_before(Cursor position, T const &value) {
+        if (empty()) {
+            push_back(value);
+            return Cursor(head_);
+        }
+        Node *current = position.node;
+        Node *new_node = nodes_.create(value, current->prev, current);
+        current->prev->next = new_node;
+        current->prev = new_node;
+        size_++;
+        return Cursor(new_node);
+    }
+
+    iterator begin() noexcept {
+        return iterator(head_, size_);
+    }
+
+    iterator end() noexcept {
+        return iterator(head_, 0);
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(head_, size_);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(head_, 0);
+    }
+
     friend std::ostream &operator<<(std::ostream &os,
-                                    CircularList<T> const &list) {
+                                    CircularList const &list) {
         os << "[";
         if (!list.empty()) {
             Node *current = list.head_;
@@ -0,0 +1,124 @@
+#ifndef FENWICK_TREE_H
+#define FENWICK_TREE_H
+
+#include "arraylist.h"
+
+#ifdef __cplusplus
+# include <cstddef>
+# include <stdexcept>
+#endif
+// 树状数组(Fenwick tree)：单点加、前缀和、按前缀和查找均为 O(log n)
+// 下标从 0 开始；内部数组下标从 1 开始，tree[i] 保存 (i - lowbit(i), i] 的和。
+// 下标在入口检查一次，循环内直接访问底层数组
+template <typename T>
+class FenwickTree {
+public:
+    FenwickTree() : FenwickTree(0) {}
+
+    explicit FenwickTree(size_t n) : tree(n + 1), _size(n) {
+        for (size_t i = 0; i <= n; i++) {
+            tree.push_back(T());
+        }
+    }
+
+    // n 个元素都初始化为 value，O(n) 建树
+    FenwickTree(size_t n, T const &value) : FenwickTree(n) {
+        for (size_t i = 1; i <= n; i++) {
+            tree[i] += value;
+            size_t parent = i + lowbit(i);
+            if (parent <= n) {
+                tree[parent] += tree[i];
+            }
+        }
+    }
+
+    size_t size() const noexcept {
+        return _size;
+    }
+
+    bool empty() const noexcept {
+        return _size == 0;
+    }
+
+    // 第 index 个元素加上 delta
+    void add(size_t index, T const &delta) {
+        check_index(index);
+        T *data = tree.begin();
+        for (size_t i = index + 1; i <= _size; i += lowbit(i)) {
+            data[i] += delta;
+        }
+    }
+
+    // 前 count 个元素之和，即 [0, count)
+    T prefix_sum(size_t count) const {
+        if (count > _size) {
+            throw std::out_of_range("count out of range");
+        }
+        T const *data = tree.begin();
+        T sum = T();
+        for (size_t i = count; i > 0; i -= lowbit(i)) {
+            sum += data[i];
+        }
+        return sum;
+    }
+
+    // 区间 [first, last) 之和
+    T sum(size_t first, size_t last) const {
+        if (first > last) {
+            throw std::out_of_range("invalid range");
+        }
+        return prefix_sum(last) - prefix_sum(first);
+    }
+
+    // 第 index 个元素的值
+    T at(size_t index) const {
+        check_index(index);
+        return sum(index, index + 1);
+    }
+
+    // 前缀和大于 target 的最短前缀的最后一个下标，不存在时返回 size()。
+    // 元素均非负时，对 0/1 标记即为第 target 个(从 0 数)为 1 的位置。
+    // rest 不为空时写入 target 减去该下标之前的前缀和，即在该元素内的偏移
+    size_t find(T target, T *rest = nullptr) const {
+        T const *data = tree.begin();
+        size_t pos = 0;
+        for (size_t step = highest_bit(_size); step > 0; step >>= 1) {
+            size_t next = pos + step;
+            if (next <= _size) {
+                // 写成条件赋值，编译器可生成无分支的代码
+                T value = data[next];
+                bool right = !(target < value);
+                pos = right ? next : pos;
+                target = right ? target - value : target;
+            }
+        }
+        if (rest != nullptr) {
+            *rest = target;
+        }
+        return pos;
+    }
+
+private:
+    ArrayList<T> tree;
+    size_t _size;
+
+    static size_t lowbit(size_t i) {
+        return i & (~i + 1);
+    }
+
+    static size_t highest_bit(size_t n) {
+        size_t bit = 1;
+        while (bit <= n / 2) {
+            bit <<= 1;
+        }
+        return n == 0 ? 0 : bit;
+    }
+
+    void check_index(size_t index) const {
+        if (index >= _size) {
+            throw std::out_of_range("index out of range");
+        }
+    }
+};
+
+#endif // !FENWICK_TREE_H
@@ -4,37 +4,43 @@
 # include <cstddef>
 # include <stdexcept>
 #endif
-template <typename T>
+// 线性表的静态接口(CRTP)：Derived 为具体的表，以
+//     class ArrayList : public LinearList<ArrayList<T>, T>
+// 的形式继承。不含虚函数，容器里没有虚表指针，通过基类调用也是直接调用。
+// Derived 需要提供以下成员：
+//     empty() size() clear() at(index) insert(index, value) erase(index)
+//     push_back(value) pop_back() front() back() replace(index, value)
+//     begin() end() (前向迭代器)
+// 对任意种类的表通用的算法见 algorithms.h
+template <typename Derived, typename T>
 class LinearList {
 public:
-    virtual ~LinearList() = default;
+    using value_type = T;
 
-    virtual bool empty() const noexcept = 0;
-    virtual size_t size() const noexcept = 0;
-    virtual void clear() noexcept = 0;
-    virtual T &at(size_t index) = 0;
-    virtual T const &at(size_t index) const = 0;
-
-    virtual void insert(size_t index, T const &value) = 0;
-    virtual void erase(size_t index) = 0;
-    virtual void push_back(T const &value) = 0;
-    virtual void pop_back() = 0;
-    virtual T &front() = 0;
-    virtual T const &front() const = 0;
-    virtual T &back() = 0;
-    virtual T const &back() const = 0;
+    Derived &derived() noexcept {
+        return static_cast<Derived &>(*this);
+    }
 
-    virtual void replace(size_t index, T const &value) = 0;
+    Derived const &derived() const noexcept {
+        return static_cast<Derived const &>(*this);
+    }
 
 protected:
+    LinearList() = default;
+    LinearList(LinearList const &) = default;
+    LinearList &operator=(LinearList const &) = default;
+    // 不允许通过基类指针删除
+    ~LinearList() = default;
+
     void check_index(size_t index, bool end = false) const {
-        if ((!end && index >= size()) || (end && index > size())) {
+        size_t size = derived().size();
+        if ((!end && index >= size) || (end && index > size)) {
             throw std::out_of_range("out of range");
         }
     }
 
     void check_empty() const {
-        if (empty()) {
+        if (derived().empty()) {
             throw std::runtime_error("empty!");
         }
     }
@@ -2,10 +2,13 @@
 #define LINKED_LIST_H
 
 #include "linearlist.h"
+#include "nodepool.h"
 #include <ostream>
+#include <type_traits>
 
-template <typename T>
-class LinkedList : LinearList<T> {
+// Allocator 为结点分配策略，见 nodepool.h
+template <typename T, template <typename> class Allocator = NewAllocator>
+class LinkedList : public LinearList<LinkedList<T, Allocator>, T> {
 private:
     struct Node {
         T data;
@@ -21,6 +24,7 @@ private:
     Node *head_;
     Node *tail_;
     size_t size_;
+    Allocator<Node> nodes_;
 
     Node *locate(size_t index) const {
         Node *current;
@@ -38,16 +42,50 @@ private:
         return current;
     }
 
-    void swap(LinkedList<T> &other) noexcept {
+    void swap(LinkedList &other) noexcept {
         std::swap(head_, other.head_);
         std::swap(tail_, other.tail_);
         std::swap(size_, other.size_);
+        nodes_.swap(other.nodes_);
     }
 
+    template <typename Value>
+    class Iterator {
+    public:
+        explicit Iterator(Node *node) : node(node) {}
+
+        Value &operator*() const {
+            return node->data;
+        }
+
+        Value *operator->() const {
+            return &node->data;
+        }
+
+        Iterator &operator++() {
+            node = node->next;
+            return *this;
+        }
+
+        bool operator==(Iterator const &other) const {
+            return node == other.node;
+        }
+
+        bool operator!=(Iterator const &other) const {
+            return node != other.node;
+        }
+
+    private:
+        Node *node;
+    };
+
 public:
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<T const>;
+
     LinkedList() : head_(nullptr), tail_(nullptr), size_(0) {};
 
-    LinkedList(LinkedList<T> const &other)
+    LinkedList(LinkedList const &other)
         : head_(nullptr),
           tail_(nullptr),
           size_(0) {
@@ -58,130 +96,139 @@ public:
         }
     }
 
-    LinkedList(LinkedList<T> &&other)
+    LinkedList(LinkedList &&other)
         : head_(other.head_),
           tail_(other.tail_),
-          size_(other.size_) {
+          size_(other.size_),
+          nodes_(std::move(other.nodes_)) {
         other.head_ = nullptr;
         other.tail_ = nullptr;
         other.size_ = 0;
     }
 
-    LinkedList<T> &operator=(LinkedList<T> const &other) {
+    LinkedList &operator=(LinkedList const &other) {
         if (this != &other) {
-            LinkedList<T> temp(other);
+            LinkedList temp(other);
             swap(temp);
         }
         return *this;
     }
 
-    LinkedList<T> &operator=(LinkedList<T> &&other) noexcept {
+    LinkedList &operator=(LinkedList &&other) noexcept {
         if (this != &other) {
             swap(other);
         }
         return *this;
     }
 
-    ~LinkedList() override {
+    ~LinkedList() {
         clear();
     }
 
-    bool empty() const noexcept override {
+    bool empty() const noexcept {
         return size_ == 0;
     }
 
-    size_t size() const noexcept override {
+    size_t size() const noexcept {
         return size_;
     }
 
-    void clear() noexcept override {
+    void clear() noexcept {
+        // 结点可平凡析构时整块释放内存池，不必逐个释放
+        if (Allocator<Node>::can_reset &&
+            std::is_trivially_destructible<Node>::value) {
+            nodes_.reset();
+            head_ = nullptr;
+        }
         while (head_ != nullptr) {
             Node *tmp = head_;
             head_ = head_->next;
-            delete tmp;
+            nodes_.destroy(tmp);
         }
         tail_ = nullptr;
         size_ = 0;
     }
 
-    T &at(size_t index) override {
+    T &at(size_t index) {
         this->check_index(index);
         return locate(index)->data;
     }
 
-    T const &at(size_t index) const override {
+    T const &at(size_t index) const {
         this->check_index(index);
         return locate(index)->data;
     }
 
-    void insert(size_t index, T const &value) override {
+    void insert(size_t index, T const &value) {
         this->check_index(index, true);
         if (index == 0) {
-            Node *new_node = new Node(value, nullptr, head_);
+            Node *new_node = nodes_.create(value, nullptr, head_);
             if (head_) {
                 head_->prev = new_node;
             } else {
                 tail_ = new_node;
             }
+            head_ = new_node;
 
         } else if (index == size_) {
-            Node *new_node = new Node(value, tail_, nullptr);
+            Node *new_node = nodes_.create(value, tail_, nullptr);
             if (tail_) {
                 tail_->next = new_node;
             } else {
                 head_ = new_node;
             }
+            tail_ = new_node;
         } else {
             Node *current = locate(index);
-            Node *new_node = new Node(value, current->prev, current);
+            Node *new_node = nodes_.create(value, current->prev, current);
             current->prev->next = new_node;
             current->prev = new_node;
         }
         ++size_;
     }
 
-    T &front() override {
+    T &front() {
         this->check_empty();
         return head_->data;
     }
 
-    T const &front() const override {
+    T const &front() const {
         this->check_empty();
         return head_->data;
     }
 
-    T &back() override {
+    T &back() {
         this->check_empty();
         return tail_->data;
     }
 
-    T const &back() const override {
+    T const &back() const {
         this->check_empty();
         return tail_->data;
     }
 
-    void replace(size_t index, T const &value) override {
+    void replace(size_t index, T const &value) {
         this->check_index(index);
         locate(index)->data = value;
     }
 
-    void push_back(T value) override {
+    void push_back(T const &value) {
         if (empty()) {
-            head_ = tail_ = new Node(value);
+            head_ = tail_ = nodes_.create(value);
         } else {
-            Node *new_node = new Node(value, tail_, nullptr);
+            Node *new_node = nodes_.create(value, tail_, nullptr);
             tail_->next = new_node;
             tail_ = new_node;
         }
         ++size_;
     }
 
-    void pop_back() override {
+    void pop_back() {
         this->check_empty();
         erase(size_ - 1);
     }
 
-    void erase(size_t index) override {
+    void erase(size_t index) {
         this->check_index(index);
         Node *delete_;
         if (index == 0) {
@@ -201,12 +248,28 @@ public:
             delete_->next->prev = delete_->prev;
             delete_->prev->next = delete_->next;
         }
-        delete delete_;
+        nodes_.destroy(delete_);
         size_--;
     }
 
+    iterator begin() noexcept {
+        return iterator(head_);
+    }
+
+    iterator end() noexcept {
+        return iterator(nullptr);
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(head_);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(nullptr);
+    }
+
     friend std::ostream &operator<<(std::ostream &os,
-                                    LinkedList<T> const &other) {
+                                    LinkedList const &other) {
         os << "[";
         if (!other.empty()) {
             Node *cur = other.head_;
@@ -0,0 +1,196 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#ifdef __cplusplus
+# include <cstddef>
+# include <new>
+# include <type_traits>
+# include <utility>
+#endif
+// 结点内存池：按块(slab)成批申请内存，释放的结点挂在空闲链表上复用。
+// 块的大小从 16 个结点开始倍增，最多 4096 个结点。
+// reset() 一次释放所有块，不逐个析构结点，只适用于结点可平凡析构的情形
+template <typename Node>
+class NodePool {
+public:
+    NodePool() : free_list(nullptr), chunks(nullptr), next_chunk(MIN_CHUNK) {}
+
+    NodePool(NodePool const &) = delete;
+    NodePool &operator=(NodePool const &) = delete;
+
+    NodePool(NodePool &&other) noexcept
+        : free_list(other.free_list),
+          chunks(other.chunks),
+          next_chunk(other.next_chunk) {
+        other.free_list = nullptr;
+        other.chunks = nullptr;
+        other.next_chunk = MIN_CHUNK;
+    }
+
+    NodePool &operator=(NodePool &&other) noexcept {
+        if (this != &other) {
+            swap(other);
+        }
+        return *this;
+    }
+
+    ~NodePool() {
+        reset();
+    }
+
+    template <typename... Args>
+    Node *create(Args &&...args) {
+        if (free_list == nullptr) {
+            grow();
+        }
+        Slot *slot = free_list;
+        free_list = slot->next;
+        try {
+            return new (slot->storage) Node(std::forward<Args>(args)...);
+        } catch (...) {
+            slot->next = free_list;
+            free_list = slot;
+            throw;
+        }
+    }
+
+    void destroy(Node *node) noexcept {
+        node->~Node();
+        Slot *slot = reinterpret_cast<Slot *>(node);
+        slot->next = free_list;
+        free_list = slot;
+    }
+
+    // 释放所有块。池中仍在使用的结点不会被析构
+    void reset() noexcept {
+        while (chunks != nullptr) {
+            Chunk *next = chunks->next;
+            ::operator delete(chunks);
+            chunks = next;
+        }
+        free_list = nullptr;
+        next_chunk = MIN_CHUNK;
+    }
+
+    void swap(NodePool &other) noexcept {
+        std::swap(free_list, other.free_list);
+        std::swap(chunks, other.chunks);
+        std::swap(next_chunk, other.next_chunk);
+    }
+
+private:
+    union Slot {
+        Slot *next;
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+    // 块头之后紧跟 count 个 Slot
+    struct Chunk {
+        Chunk *next;
+        size_t count;
+    };
+
+    static constexpr size_t MIN_CHUNK = 16;
+    static constexpr size_t MAX_CHUNK = 4096;
+    // 块头占用的字节数，向上取整到 Slot 的对齐
+    static constexpr size_t HEADER =
+        (sizeof(Chunk) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+
+    Slot *free_list;
+    Chunk *chunks;
+    size_t next_chunk;
+
+    void grow() {
+        static_assert(alignof(Slot) <= alignof(std::max_align_t),
+                      "over-aligned nodes are not supported");
+        size_t count = next_chunk;
+        void *memory = ::operator new(HEADER + count * sizeof(Slot));
+        Chunk *chunk = static_cast<Chunk *>(memory);
+        chunk->next = chunks;
+        chunk->count = count;
+        chunks = chunk;
+        Slot *slots = reinterpret_cast<Slot *>(static_cast<char *>(memory) +
+                                               HEADER);
+        for (size_t i = count; i-- > 0;) {
+            slots[i].next = free_list;
+            free_list = &slots[i];
+        }
+        if (next_chunk < MAX_CHUNK) {
+            next_chunk *= 2;
+        }
+    }
+};
+
+// 以下为容器的结点分配策略，容器以 Allocator<Node> 的形式使用。
+// can_reset 为真时容器可在 clear 时调用 reset() 整块释放(结点可平凡析构时)
+
+// 每个结点单独 new/delete，与原来的行为相同
+template <typename Node>
+struct NewAllocator {
+    static constexpr bool can_reset = false;
+
+    template <typename... Args>
+    Node *create(Args &&...args) {
+        return new Node(std::forward<Args>(args)...);
+    }
+
+    void destroy(Node *node) noexcept {
+        delete node;
+    }
+
+    void reset() noexcept {}
+
+    void swap(NewAllocator &) noexcept {}
+};
+
+// 每个容器独占一个内存池，清空时整块释放
+template <typename Node>
+struct PooledAllocator {
+    static constexpr bool can_reset = true;
+
+    template <typename... Args>
+    Node *create(Args &&...args) {
+        return pool.create(std::forward<Args>(args)...);
+    }
+
+    void destroy(Node *node) noexcept {
+        pool.destroy(node);
+    }
+
+    void reset() noexcept {
+        pool.reset();
+    }
+
+    void swap(PooledAllocator &other) noexcept {
+        pool.swap(other.pool);
+    }
+
+    NodePool<Node> pool;
+};
+
+// 同一线程中同类结点共用一个线程局部的内存池，不需要加锁。
+// 结点必须在分配它的线程中释放，且容器不能比该线程活得更久
+template <typename Node>
+struct ThreadLocalAllocator {
+    static constexpr bool can_reset = false;
+
+    static NodePool<Node> &pool() {
+        thread_local NodePool<Node> instance;
+        return instance;
+    }
+
+    template <typename... Args>
+    Node *create(Args &&...args) {
+        return pool().create(std::forward<Args>(args)...);
+    }
+
+    void destroy(Node *node) noexcept {
+        pool().destroy(node);
+    }
+
+    void reset() noexcept {}
+
+    void swap(ThreadLocalAllocator &) noexcept {}
+};
+
+#endif // !NODE_POOL_H
@@ -0,0 +1,359 @@
+#ifndef SKIP_LIST_H
+#define SKIP_LIST_H
+
+#include "linearlist.h"
+
+#ifdef __cplusplus
+# include <cstddef>
+# include <cstdint>
+# include <new>
+# include <ostream>
+# include <utility>
+#endif
+// 可按下标访问的跳表：按位置而不是按键排列元素。
+// 每层的链接记录跨度(跳过的元素个数)，按下标查找时从最高层向下，
+// 累加跨度直到到达目标位置；按位置访问、插入和删除的期望代价都是 O(log n)。
+// 结点高度按 p = 1/4 随机选取，平均每个结点 4/3 个链接。
+// 表头不是结点，它的各层链接单独保存，因此不要求 T 可默认构造
+template <typename T>
+class SkipList : public LinearList<SkipList<T>, T> {
+    static constexpr size_t MAX_LEVEL = 24; // 4^24 远超可能的元素个数
+
+    struct Node;
+
+    struct Link {
+        Node *next;
+        size_t span; // 到 next 跨过的位置数，next 为空时无意义
+    };
+
+    // 结点之后紧跟 height 个 Link，与结点一起分配
+    struct Node {
+        T data;
+
+        explicit Node(T const &value) : data(value) {}
+
+        Link *links() noexcept {
+            return reinterpret_cast<Link *>(reinterpret_cast<char *>(this) +
+                                            LINK_OFFSET);
+        }
+    };
+
+    static constexpr size_t LINK_OFFSET =
+        (sizeof(Node) + alignof(Link) - 1) / alignof(Link) * alignof(Link);
+
+    template <typename Value>
+    class Iterator {
+    public:
+        explicit Iterator(Node *node) : node(node) {}
+
+        Value &operator*() const {
+            return node->data;
+        }
+
+        Value *operator->() const {
+            return &node->data;
+        }
+
+        Iterator &operator++() {
+            node = node->links()[0].next;
+            return *this;
+        }
+
+        bool operator==(Iterator const &other) const {
+            return node == other.node;
+        }
+
+        bool operator!=(Iterator const &other) const {
+            return node != other.node;
+        }
+
+    private:
+        Node *node;
+    };
+
+public:
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<T const>;
+
+    SkipList()
+        : tail_(nullptr),
+          size_(0),
+          level_(1),
+          seed_(0x9E3779B97F4A7C15) {
+        for (Link &link: head_) {
+            link.next = nullptr;
+            link.span = 0;
+        }
+    }
+
+    SkipList(SkipList const &other) : SkipList() {
+        for (T const &value: other) {
+            push_back(value);
+        }
+    }
+
+    SkipList(SkipList &&other) noexcept : SkipList() {
+        swap(other);
+    }
+
+    SkipList &operator=(SkipList const &other) {
+        if (this != &other) {
+            SkipList temp(other);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    SkipList &operator=(SkipList &&other) noexcept {
+        if (this != &other) {
+            swap(other);
+        }
+        return *this;
+    }
+
+    ~SkipList() {
+        clear();
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_t size() const noexcept {
+        return size_;
+    }
+
+    void clear() noexcept {
+        Node *node = head_[0].next;
+        while (node != nullptr) {
+            Node *next = node->links()[0].next;
+            destroy_node(node);
+            node = next;
+        }
+        for (Link &link: head_) {
+            link.next = nullptr;
+            link.span = 0;
+        }
+        tail_ = nullptr;
+        size_ = 0;
+        level_ = 1;
+    }
+
+    T &at(size_t index) {
+        this->check_index(index);
+        return locate(index)->data;
+    }
+
+    T const &at(size_t index) const {
+        this->check_index(index);
+        return locate(index)->data;
+    }
+
+    void insert(size_t index, T const &value) {
+        this->check_index(index, true);
+        Link *update[MAX_LEVEL];
+        size_t rank[MAX_LEVEL];
+        find_before(index, update, rank);
+
+        size_t height = random_height();
+        if (height > level_) {
+            for (size_t level = level_; level < height; level++) {
+                update[level] = head_;
+                rank[level] = 0;
+                head_[level].span = size_;
+            }
+            level_ = height;
+        }
+        Node *node = create_node(value, height);
+        Link *links = node->links();
+        for (size_t level = 0; level < height; level++) {
+            Link &before = update[level][level];
+            size_t skipped = rank[0] - rank[level]; // 前驱到新结点之间的元素
+            links[level].next = before.next;
+            links[level].span = before.span - skipped;
+            before.next = node;
+            before.span = skipped + 1;
+        }
+        for (size_t level = height; level < level_; level++) {
+            update[level][level].span++;
+        }
+        if (links[0].next == nullptr) {
+            tail_ = node;
+        }
+        size_++;
+    }
+
+    void erase(size_t index) {
+        this->check_index(index);
+        Link *update[MAX_LEVEL];
+        size_t rank[MAX_LEVEL];
+        find_before(index, update, rank);
+
+        Node *node = update[0][0].next;
+        Link *links = node->links();
+        for (size_t level = 0; level < level_; level++) {
+            Link &before = update[level][level];
+            if (before.next == node) {
+                before.next = links[level].next;
+                before.span += links[level].span - 1;
+            } else {
+                before.span--;
+            }
+        }
+        if (node == tail_) {
+            // 前驱的第 0 层链接就在前驱结点之后
+            tail_ = index == 0 ? nullptr
+                               : reinterpret_cast<Node *>(
+                                     reinterpret_cast<char *>(update[0]) -
+                                     LINK_OFFSET);
+        }
+        while (level_ > 1 && head_[level_ - 1].next == nullptr) {
+            level_--;
+        }
+        destroy_node(node);
+        size_--;
+    }
+
+    void push_back(T const &value) {
+        insert(size_, value);
+    }
+
+    void pop_back() {
+        this->check_empty();
+        erase(size_ - 1);
+    }
+
+    T &front() {
+        this->check_empty();
+        return head_[0].next->data;
+    }
+
+    T const &front() const {
+        this->check_empty();
+        return head_[0].next->data;
+    }
+
+    T &back() {
+        this->check_empty();
+        return tail_->data;
+    }
+
+    T const &back() const {
+        this->check_empty();
+        return tail_->data;
+    }
+
+    void replace(size_t index, T const &value) {
+        at(index) = value;
+    }
+
+    iterator begin() noexcept {
+        return iterator(head_[0].next);
+    }
+
+    iterator end() noexcept {
+        return iterator(nullptr);
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(head_[0].next);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(nullptr);
+    }
+
+    friend std::ostream &operator<<(std::ostream &os, SkipList const &list) {
+        os << "[";
+        bool first = true;
+        for (T const &value: list) {
+            if (!first) {
+                os << ' ';
+            }
+            os << value;
+            first = false;
+        }
+        os << "]";
+        return os;
+    }
+
+private:
+    Link head_[MAX_LEVEL];
+    Node *tail_;
+    size_t size_;
+    size_t level_; // 当前使用的层数，至少为 1
+    uint64_t seed_;
+
+    // 第 index 个元素所在的结点
+    Node *locate(size_t index) const {
+        Link const *links = head_;
+        size_t position = 0; // links 所属结点的位置，表头为 0，元素从 1 数
+        Node *node = nullptr;
+        for (size_t level = level_; level-- > 0;) {
+            while (links[level].next != nullptr &&
+                   position + links[level].span <= index + 1) {
+                position += links[level].span;
+                node = links[level].next;
+                links = node->links();
+            }
+        }
+        return node;
+    }
+
+    // 找出每层上位于第 index 个位置之前的最后一个链接，
+    // rank[level] 为该链接所属结点的位置(表头为 0)
+    void find_before(size_t index, Link **update, size_t *rank) {
+        Link *links = head_;
+        size_t position = 0;
+        for (size_t level = level_; level-- > 0;) {
+            while (links[level].next != nullptr &&
+                   position + links[level].span <= index) {
+                position += links[level].span;
+                links = links[level].next->links();
+            }
+            update[level] = links;
+            rank[level] = position;
+        }
+    }
+
+    // 高度为 h 的概率为 (1/4)^(h-1) * 3/4
+    size_t random_height() noexcept {
+        seed_ ^= seed_ << 13;
+        seed_ ^= seed_ >> 7;
+        seed_ ^= seed_ << 17;
+        uint64_t bits = seed_;
+        size_t height = 1;
+        while (height < MAX_LEVEL && (bits & 3) == 0) {
+            height++;
+            bits >>= 2;
+        }
+        return height;
+    }
+
+    static Node *create_node(T const &value, size_t height) {
+        void *memory = ::operator new(LINK_OFFSET + height * sizeof(Link));
+        try {
+            return new (memory) Node(value);
+        } catch (...) {
+            ::operator delete(memory);
+            throw;
+        }
+    }
+
+    static void destroy_node(Node *node) noexcept {
+        node->~Node();
+        ::operator delete(node);
+    }
+
+    void swap(SkipList &other) noexcept {
+        for (size_t level = 0; level < MAX_LEVEL; level++) {
+            std::swap(head_[level], other.head_[level]);
+        }
+        std::swap(tail_, other.tail_);
+        std::swap(size_, other.size_);
+        std::swap(level_, other.level_);
+        std::swap(seed_, other.seed_);
+    }
+};
+
+#endif // !SKIP_LIST_H
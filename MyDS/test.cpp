@@ -1,4 +1,10 @@
+#include "algorithms.h"
 #include "arraylist.h"
+#include "circularlist.h"
+#include "fenwicktree.h"
+#include "linkedlist.h"
+#include "skiplist.h"
+#include "unrolledlist.h"
 #include <cassert>
 #include <iostream>
 #include <string>
@@ -118,6 +124,229 @@ void testReplace() {
     assert(list.at(1) == 20);
 }
 
+void testFenwickTree() {
+    std::cout << "\n=== Testing FenwickTree ===\n";
+
+    FenwickTree<int> tree(10, 1);
+    assert(tree.size() == 10);
+    assert(tree.prefix_sum(0) == 0);
+    assert(tree.prefix_sum(10) == 10);
+
+    tree.add(3, 4);
+    tree.add(7, -1);
+    assert(tree.at(3) == 5);
+    assert(tree.at(7) == 0);
+    assert(tree.sum(2, 5) == 7);
+    assert(tree.prefix_sum(10) == 13);
+
+    // 按前缀和查找：0/1 标记时即第 k 个为 1 的位置
+    FenwickTree<int> alive(8, 1);
+    alive.add(0, -1);
+    alive.add(5, -1);
+    assert(alive.find(0) == 1);
+    assert(alive.find(4) == 6);
+    assert(alive.find(6) == 8);
+    int rest = -1;
+    assert(tree.find(5, &rest) == 3 && rest == 2);
+
+    try {
+        tree.add(10, 1);
+        assert(false); // 不应该到达这里
+    } catch (std::out_of_range const &e) {
+        std::cout << "Expected error caught: " << e.what() << std::endl;
+    }
+}
+
+void testCircularListCursor() {
+    std::cout << "\n=== Testing CircularList Cursor ===\n";
+
+    CircularList<int> circle;
+    assert(!circle.cursor());
+    auto cursor = circle.insert_before(circle.cursor(), 1);
+    for (int i = 2; i <= 7; i++) {
+        circle.push_back(i);
+    }
+    assert(*cursor == 1);
+    assert(*circle.advance(cursor, 2) == 3);
+    assert(*circle.advance(cursor, 6) == 7);  // 向前走 1 步
+    assert(*circle.advance(cursor, 15) == 2); // 环绕
+
+    // 用游标模拟 m = 3 的约瑟夫环
+    int expected[] = {3, 6, 2, 7, 5, 1, 4};
+    CircularList<int> copy(circle);
+    assert(copy.size() == 7);
+    cursor = copy.cursor();
+    for (int id: expected) {
+        cursor = copy.advance(cursor, 2);
+        assert(*cursor == id);
+        cursor = copy.erase_at(cursor);
+    }
+    assert(copy.empty() && !cursor);
+
+    // 在表头之前插入即成为表尾
+    cursor = circle.insert_before(circle.cursor(), 0);
+    assert(circle.back() == 0 && circle.front() == 1);
+    circle.insert_before(circle.cursor(3), 10);
+    assert(circle.at(3) == 10 && circle.at(4) == 4);
+    std::cout << "After cursor inserts: " << circle << std::endl;
+}
+
+void testUnrolledList() {
+    std::cout << "\n=== Testing UnrolledList ===\n";
+
+    // 与 ArrayList 对照随机插入和删除
+    UnrolledList<int, 4> list;
+    ArrayList<int> expected;
+    unsigned seed = 1;
+    for (int i = 0; i < 500; i++) {
+        seed = seed * 1103515245 + 12345;
+        size_t r = seed >> 8;
+        if (expected.empty() || r % 3 != 0) {
+            size_t index = r % (expected.size() + 1);
+            list.insert(index, i);
+            expected.insert(index, i);
+        } else {
+            size_t index = r % expected.size();
+            list.erase(index);
+            expected.erase(index);
+        }
+        assert(list.size() == expected.size());
+    }
+    size_t i = 0;
+    for (int value: list) {
+        assert(value == expected[i++]);
+        assert(list.at(i - 1) == value);
+    }
+    assert(i == expected.size());
+
+    // 顺序追加时结点保持是满的
+    UnrolledList<int, 4> appended;
+    for (int k = 0; k < 10; k++) {
+        appended.push_back(k);
+    }
+    assert(appended.node_count() == 3);
+    assert(appended.front() == 0 && appended.back() == 9);
+    appended.replace(5, 50);
+    UnrolledList<int, 4> copy(appended);
+    copy.pop_back();
+    assert(copy.size() == 9 && copy.at(5) == 50 && appended.size() == 10);
+    std::cout << "UnrolledList: " << appended << std::endl;
+}
+
+void testNodePool() {
+    std::cout << "\n=== Testing NodePool ===\n";
+
+    LinkedList<int, PooledAllocator> list;
+    for (int i = 0; i < 100; i++) {
+        list.push_back(i);
+    }
+    list.insert(0, -1);
+    list.insert(list.size(), 100);
+    list.insert(50, 0);
+    assert(list.size() == 103);
+    assert(list.front() == -1 && list.back() == 100 && list.at(50) == 0);
+    list.erase(50);
+    list.erase(0);
+    assert(list.at(10) == 10);
+    LinkedList<int, PooledAllocator> moved(std::move(list));
+    assert(list.empty() && moved.size() == 101);
+    moved.clear(); // 整块释放
+    assert(moved.empty());
+    moved.push_back(7);
+    assert(moved.front() == 7 && moved.back() == 7);
+
+    // 结点不可平凡析构时逐个析构，释放的结点留在线程局部池中复用
+    CircularList<std::string, ThreadLocalAllocator> names;
+    names.push_back("a");
+    names.push_back("b");
+    names.insert(1, "c");
+    CircularList<std::string, ThreadLocalAllocator> copy(names);
+    names.erase(0);
+    assert(names.front() == "c" && copy.at(1) == "c" && copy.size() == 3);
+    std::cout << "Pooled CircularList: " << copy << std::endl;
+}
+
+void testSkipList() {
+    std::cout << "\n=== Testing SkipList ===\n";
+
+    // 与 ArrayList 对照随机插入、删除和按下标访问
+    SkipList<int> list;
+    ArrayList<int> expected;
+    unsigned seed = 7;
+    for (int i = 0; i < 2000; i++) {
+        seed = seed * 1103515245 + 12345;
+        size_t r = seed >> 8;
+        if (expected.empty() || r % 3 != 0) {
+            size_t index = r % (expected.size() + 1);
+            list.insert(index, i);
+            expected.insert(index, i);
+        } else {
+            size_t index = r % expected.size();
+            list.erase(index);
+            expected.erase(index);
+        }
+        if (!expected.empty()) {
+            size_t probe = (r >> 4) % expected.size();
+            assert(list.at(probe) == expected[probe]);
+            assert(list.back() == expected[expected.size() - 1]);
+        }
+    }
+    size_t i = 0;
+    for (int value: list) {
+        assert(value == expected[i++]);
+    }
+    assert(i == list.size());
+
+    SkipList<int> copy(list);
+    while (!list.empty()) {
+        list.pop_back();
+    }
+    assert(list.empty() && copy.size() == expected.size());
+    copy.replace(0, -1);
+    assert(copy.front() == -1);
+    list.push_back(1);
+    list.insert(0, 0);
+    std::cout << "SkipList: " << list << std::endl;
+}
+
+// 同一段代码对各种表都可以使用
+template <typename List>
+void checkAlgorithms(List &list) {
+    int values[] = {5, 3, 9, 1, 7};
+    for (int value: values) {
+        list.push_back(value);
+    }
+    assert(find(list, 9) == 2 && find(list, 4) == list.size());
+    assert(accumulate(list, 0) == 25);
+    assert(accumulate(list, 1, std::multiplies<int>()) == 945);
+    sort(list);
+    int expected[] = {1, 3, 5, 7, 9};
+    size_t i = 0;
+    for (int value: list) {
+        assert(value == expected[i++]);
+    }
+    sort(list, std::greater<int>());
+    assert(list.front() == 9 && list.back() == 1);
+}
+
+void testAlgorithms() {
+    std::cout << "\n=== Testing Algorithms ===\n";
+
+    ArrayList<int> array;
+    LinkedList<int> linked;
+    CircularList<int> circular;
+    UnrolledList<int, 2> unrolled;
+    SkipList<int> skip;
+    checkAlgorithms(array);
+    checkAlgorithms(linked);
+    checkAlgorithms(circular);
+    checkAlgorithms(unrolled);
+    checkAlgorithms(skip);
+    // 静态接口不引入虚表指针
+    assert(sizeof(ArrayList<int>) == sizeof(int *) + 2 * sizeof(size_t));
+    std::cout << "Sorted CircularList: " << circular << std::endl;
+}
+
 int main() {
     try {
         testBasicOperations();
@@ -125,6 +354,12 @@ int main() {
         testCopyAndMove();
         testExceptionHandling();
         testReplace();
+        testFenwickTree();
+        testCircularListCursor();
+        testUnrolledList();
+        testNodePool();
+        testSkipList();
+        testAlgorithms();
 
         std::cout << "\nAll tests passed successfully!\n";
     } catch (std::exception const &e) {
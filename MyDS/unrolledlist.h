@@ -0,0 +1,342 @@
+#ifndef UNROLLED_LIST_H
+#define UNROLLED_LIST_H
+
+#include "linearlist.h"
+
+#ifdef __cplusplus
+# include <cstddef>
+# include <ostream>
+# include <utility>
+#endif
+// 展开链表：每个结点存放至多 N 个元素的小数组，结点之间双向链接。
+// 与每个元素一个结点的链表相比，指针开销和缓存缺失都约为 1/N；
+// 按下标访问从较近的一端逐结点跳过，插入删除只移动一个结点内的元素。
+// 插入满结点时对半分裂，删除后结点与后继合计不超过 N/2 个时合并，
+// 避免留下大量几乎为空的结点；追加到表尾时前面的结点保持是满的
+template <typename T, size_t N = 64>
+class UnrolledList : public LinearList<UnrolledList<T, N>, T> {
+    static_assert(N >= 2, "node capacity must be at least 2");
+
+    struct Node {
+        T data[N];
+        size_t count;
+        Node *prev;
+        Node *next;
+
+        Node() : count(0), prev(nullptr), next(nullptr) {}
+    };
+
+    template <typename Value, typename NodePtr>
+    class Iterator {
+    public:
+        Iterator(NodePtr node, size_t offset) : node(node), offset(offset) {}
+
+        Value &operator*() const {
+            return node->data[offset];
+        }
+
+        Value *operator->() const {
+            return &node->data[offset];
+        }
+
+        Iterator &operator++() {
+            if (++offset == node->count) {
+                node = node->next;
+                offset = 0;
+            }
+            return *this;
+        }
+
+        bool operator==(Iterator const &other) const {
+            return node == other.node && offset == other.offset;
+        }
+
+        bool operator!=(Iterator const &other) const {
+            return !(*this == other);
+        }
+
+    private:
+        NodePtr node;
+        size_t offset;
+    };
+
+public:
+    using iterator = Iterator<T, Node *>;
+    using const_iterator = Iterator<T const, Node const *>;
+
+    UnrolledList() : head_(nullptr), tail_(nullptr), size_(0) {}
+
+    UnrolledList(UnrolledList const &other) : UnrolledList() {
+        for (Node *node = other.head_; node != nullptr; node = node->next) {
+            Node *copy = append_node();
+            for (size_t i = 0; i < node->count; i++) {
+                copy->data[i] = node->data[i];
+            }
+            copy->count = node->count;
+            size_ += node->count;
+        }
+    }
+
+    UnrolledList(UnrolledList &&other) noexcept
+        : head_(other.head_),
+          tail_(other.tail_),
+          size_(other.size_) {
+        other.head_ = nullptr;
+        other.tail_ = nullptr;
+        other.size_ = 0;
+    }
+
+    UnrolledList &operator=(UnrolledList const &other) {
+        if (this != &other) {
+            UnrolledList temp(other);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    UnrolledList &operator=(UnrolledList &&other) noexcept {
+        if (this != &other) {
+            swap(other);
+        }
+        return *this;
+    }
+
+    ~UnrolledList() {
+        clear();
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_t size() const noexcept {
+        return size_;
+    }
+
+    // 结点个数，用于观察空间利用率
+    size_t node_count() const noexcept {
+        size_t count = 0;
+        for (Node *node = head_; node != nullptr; node = node->next) {
+            count++;
+        }
+        return count;
+    }
+
+    void clear() noexcept {
+        while (head_ != nullptr) {
+            Node *next = head_->next;
+            delete head_;
+            head_ = next;
+        }
+        tail_ = nullptr;
+        size_ = 0;
+    }
+
+    T &at(size_t index) {
+        this->check_index(index);
+        Node *node = locate(index);
+        return node->data[index];
+    }
+
+    T const &at(size_t index) const {
+        this->check_index(index);
+        Node *node = locate(index);
+        return node->data[index];
+    }
+
+    void insert(size_t index, T const &value) {
+        this->check_index(index, true);
+        Node *node;
+        if (index == size_) {
+            // 追加到表尾：尾结点满时直接开新结点，保持前面的结点是满的
+            if (tail_ == nullptr || tail_->count == N) {
+                append_node();
+            }
+            node = tail_;
+            index = node->count;
+        } else {
+            node = locate(index);
+            if (node->count == N) {
+                split(node);
+                if (index > node->count) {
+                    index -= node->count;
+                    node = node->next;
+                }
+            }
+        }
+        for (size_t i = node->count; i > index; i--) {
+            node->data[i] = std::move(node->data[i - 1]);
+        }
+        node->data[index] = value;
+        node->count++;
+        size_++;
+    }
+
+    void erase(size_t index) {
+        this->check_index(index);
+        Node *node = locate(index);
+        for (size_t i = index + 1; i < node->count; i++) {
+            node->data[i - 1] = std::move(node->data[i]);
+        }
+        node->count--;
+        size_--;
+        if (node->count == 0) {
+            unlink(node);
+        } else if (node->next != nullptr &&
+                   node->count + node->next->count <= N / 2) {
+            merge(node);
+        }
+    }
+
+    void push_back(T const &value) {
+        insert(size_, value);
+    }
+
+    void pop_back() {
+        this->check_empty();
+        erase(size_ - 1);
+    }
+
+    T &front() {
+        this->check_empty();
+        return head_->data[0];
+    }
+
+    T const &front() const {
+        this->check_empty();
+        return head_->data[0];
+    }
+
+    T &back() {
+        this->check_empty();
+        return tail_->data[tail_->count - 1];
+    }
+
+    T const &back() const {
+        this->check_empty();
+        return tail_->data[tail_->count - 1];
+    }
+
+    void replace(size_t index, T const &value) {
+        at(index) = value;
+    }
+
+    iterator begin() noexcept {
+        return iterator(head_, 0);
+    }
+
+    iterator end() noexcept {
+        return iterator(nullptr, 0);
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(head_, 0);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(nullptr, 0);
+    }
+
+    friend std::ostream &operator<<(std::ostream &os,
+                                    UnrolledList const &list) {
+        os << "[";
+        bool first = true;
+        for (T const &value: list) {
+            if (!first) {
+                os << ' ';
+            }
+            os << value;
+            first = false;
+        }
+        os << "]";
+        return os;
+    }
+
+private:
+    Node *head_;
+    Node *tail_;
+    size_t size_;
+
+    // 第 index 个元素所在的结点，index 改为结点内的偏移；从较近的一端找
+    Node *locate(size_t &index) const {
+        if (index < size_ / 2) {
+            Node *node = head_;
+            while (index >= node->count) {
+                index -= node->count;
+                node = node->next;
+            }
+            return node;
+        }
+        size_t from_back = size_ - index; // 从表尾数第几个(从 1 数)
+        Node *node = tail_;
+        while (from_back > node->count) {
+            from_back -= node->count;
+            node = node->prev;
+        }
+        index = node->count - from_back;
+        return node;
+    }
+
+    Node *append_node() {
+        Node *node = new Node();
+        node->prev = tail_;
+        if (tail_ != nullptr) {
+            tail_->next = node;
+        } else {
+            head_ = node;
+        }
+        tail_ = node;
+        return node;
+    }
+
+    // 把满结点的后一半移到新建的后继结点
+    void split(Node *node) {
+        Node *next = new Node();
+        size_t keep = N / 2;
+        for (size_t i = keep; i < N; i++) {
+            next->data[i - keep] = std::move(node->data[i]);
+        }
+        next->count = N - keep;
+        node->count = keep;
+        next->prev = node;
+        next->next = node->next;
+        if (node->next != nullptr) {
+            node->next->prev = next;
+        } else {
+            tail_ = next;
+        }
+        node->next = next;
+    }
+
+    // 把后继结点的元素并入 node 并删除后继
+    void merge(Node *node) {
+        Node *next = node->next;
+        for (size_t i = 0; i < next->count; i++) {
+            node->data[node->count + i] = std::move(next->data[i]);
+        }
+        node->count += next->count;
+        unlink(next);
+    }
+
+    void unlink(Node *node) {
+        if (node->prev != nullptr) {
+            node->prev->next = node->next;
+        } else {
+            head_ = node->next;
+        }
+        if (node->next != nullptr) {
+            node->next->prev = node->prev;
+        } else {
+            tail_ = node->prev;
+        }
+        delete node;
+    }
+
+    void swap(UnrolledList &other) noexcept {
+        std::swap(head_, other.head_);
+        std::swap(tail_, other.tail_);
+        std::swap(size_, other.size_);
+    }
+};
+
+#endif // !UNROLLED_LIST_H
@@ -1,5 +1,5 @@
 #include "../MyDS/arraylist.h"
-#include "../MyDS/circularlist.h"
+#include "josephus.h"
 #include <iostream>
 using namespace std;
 
@@ -15,6 +15,7 @@ struct Person {
 };
 
 int main() {
+    ios::sync_with_stdio(false);
     int n;
     cin >> n;
     ArrayList<int> password;
@@ -23,20 +24,14 @@ int main() {
         cin >> temp;
         password.push_back(temp);
     }
-    ArrayList<Person> result;
-    CircularList<Person> circle;
-    for (int i = 1; i <= n; ++i) {
-        circle.push_back(Person(i, password[i - 1]));
-    }
-    int current = 0;
-    while (!circle.empty()) {
-        int m = circle.at(current).password;
-        current = (current + m - 1) % circle.size();
-        result.push_back(circle.at(current));
-        circle.erase(current);
-        if (current == circle.size()) {
-            current = 0;
+    ArrayList<Person> result(n);
+    try {
+        for (int id: JosephusSolver(password).solve()) {
+            result.push_back(Person(id, password[id - 1]));
         }
+    } catch (invalid_argument const &e) {
+        cout << e.what() << '\n';
+        return 1;
     }
     cout << result;
 }
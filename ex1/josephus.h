@@ -0,0 +1,122 @@
+#ifndef JOSEPHUS_H
+#define JOSEPHUS_H
+
+#include "../MyDS/arraylist.h"
+#include "../MyDS/fenwicktree.h"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+// 带密码的约瑟夫环：每轮由开始报数的人的密码 m 决定，报到 m 的人出列，
+// 下一轮从出列者之后的人重新开始，第一轮从编号 1 开始。
+// 在圈的人记在位图中，每 64 人一个字；树状数组记录各字中在圈的人数，
+// 按名次找人先在树状数组上找到所在的字，再在字内数位，共 O(log n)。
+// 树状数组只有 n/64 个元素，能放进缓存，n = 10^7 时也只需几秒
+class JosephusSolver {
+public:
+    /**
+     * @param passwords 第 i 个元素是编号 i + 1 的人的密码
+     * @throws std::invalid_argument 有密码不是正数
+     */
+    explicit JosephusSolver(ArrayList<int> const &passwords)
+        : passwords(passwords) {
+        for (int password: passwords) {
+            if (password <= 0) {
+                throw std::invalid_argument("password must be positive");
+            }
+        }
+    }
+
+    /**
+     * 模拟整个出列过程
+     * @return 按出列顺序排列的编号(从 1 开始)
+     */
+    ArrayList<int> solve() const {
+        size_t n = passwords.size();
+        size_t words = (n + 63) / 64;
+        ArrayList<uint64_t> alive(words);
+        FenwickTree<int> counts(words);
+        for (size_t w = 0; w < words; w++) {
+            size_t bits = w + 1 < words ? 64 : n - w * 64;
+            alive.push_back(bits == 64 ? ~uint64_t(0)
+                                       : (uint64_t(1) << bits) - 1);
+            counts.add(w, static_cast<int>(bits));
+        }
+        uint64_t *bitmap = alive.begin();
+        // 圈中第 rank 个人的位置
+        auto locate = [&](size_t rank) {
+            int rest;
+            size_t w = counts.find(static_cast<int>(rank), &rest);
+            return w * 64 + select(bitmap[w], rest);
+        };
+
+        // pos 之后(不含)第一个在圈的人，只向后看几个字，更远时按名次找
+        auto next_alive = [&](size_t pos, size_t rank) {
+            size_t w = pos / 64;
+            uint64_t word = bitmap[w] & (~uint64_t(0) << (pos % 64));
+            for (int i = 0; i < 8; i++) {
+                if (word != 0) {
+                    return w * 64 + __builtin_ctzll(word);
+                }
+                if (++w == words) {
+                    break;
+                }
+                word = bitmap[w];
+            }
+            return locate(rank);
+        };
+
+        ArrayList<int> order(n);
+        size_t remaining = n;
+        size_t rank = 0;  // 本轮从圈中第 rank 个人开始报数
+        size_t start = 0; // 该人的位置
+        while (remaining > 0) {
+            size_t m = passwords[start];
+            rank = (rank + (m - 1) % remaining) % remaining;
+            size_t pos = locate(rank);
+            bitmap[pos / 64] &= ~(uint64_t(1) << (pos % 64));
+            counts.add(pos / 64, -1);
+            remaining--;
+            order.push_back(static_cast<int>(pos + 1));
+            if (remaining == 0) {
+                break;
+            }
+            // 出列者之后的人接替它的名次；出列的是最后一名时回到开头
+            if (rank == remaining) {
+                rank = 0;
+                start = locate(0);
+            } else {
+                start = next_alive(pos, rank);
+            }
+        }
+        return order;
+    }
+
+private:
+    ArrayList<int> passwords;
+
+    // word 中第 rank 个(从 0 数)为 1 的位的位置。
+    // 先用 SWAR 算出每个字节的 1 的个数及其前缀和，定位到字节后再逐位找
+    static size_t select(uint64_t word, int rank) {
+        constexpr uint64_t ONES = 0x0101010101010101;
+        uint64_t counts = word - ((word >> 1) & 0x5555555555555555);
+        counts = (counts & 0x3333333333333333) +
+                 ((counts >> 2) & 0x3333333333333333);
+        counts = (counts + (counts >> 4)) & 0x0F0F0F0F0F0F0F0F;
+        uint64_t prefix = counts * ONES; // 第 i 字节为前 i + 1 个字节之和
+        size_t shift = 0;
+        while (static_cast<int>((prefix >> shift) & 0xFF) <= rank) {
+            shift += 8;
+        }
+        if (shift > 0) {
+            rank -= static_cast<int>((prefix >> (shift - 8)) & 0xFF);
+        }
+        uint64_t byte = (word >> shift) & 0xFF;
+        for (int i = 0; i < rank; i++) {
+            byte &= byte - 1; // 去掉最低的 1
+        }
+        return shift + __builtin_ctzll(byte);
+    }
+};
+
+#endif // !JOSEPHUS_H
@@ -1,17 +1,33 @@
 /*
  * 表达式计算器和进程调度模拟程序
  * 包含以下主要功能：
- * 1. 算术表达式的中缀、前缀、后缀转换与计算
- * 2. 进程调度算法的模拟(FCFS和SJF)
+ * 1. 算术表达式的中缀、前缀、后缀转换与计算，以及解析性能测试
+ * 2. 进程调度算法的模拟(FCFS、SJF、SRTF、RR、MLFQ和多核)，
+ *    以及从文件读入大规模任务轨迹并行比较各策略
  */
 
 #include "../MyDS/arraylist.h"  // 引入自定义动态数组类
 #include "../MyDS/arraystack.h" // 引入自定义栈类
+#include "../MyDS/pair.h"       // 引入自定义二元组类
+#include "scheduler.h"          // 任务调度模拟
+#include "trace.h"              // 轨迹读入与并行比较
+#include <atomic>     // 缓存计数器
 #include <cctype>     // 用于字符类型判断
+#include <climits>    // INT_MIN
+#include <charconv>   // from_chars
+#include <chrono>     // 性能测试计时
+#include <fstream>    // 读入轨迹文件
+#include <iomanip>    // 对齐比较表
+#include <functional> // hash
 #include <iostream>   // 标准输入输出
-#include <sstream>    // 字符串流处理
+#include <memory>     // shared_ptr
+#include <mutex>      // unique_lock
+#include <random>     // 生成测试表达式
+#include <shared_mutex> // 缓存读写锁
 #include <stdexcept>  // 异常处理
 #include <string>     // 字符串类
+#include <string_view> // 记号引用输入
+#include <unordered_map> // 缓存表
 using namespace std;
 
 /**
@@ -48,7 +64,7 @@ bool is_op(char op) {
  * @param b 第二个操作数
  * @param op 运算符
  * @return 运算结果
- * @throws runtime_error 当除数为0或运算符未知时抛出异常
+ * @throws runtime_error 当除数为0、INT_MIN 除以 -1 或运算符未知时抛出异常
  */
 int calc(int a, int b, char op) {
     switch (op) {
@@ -57,267 +73,1212 @@ int calc(int a, int b, char op) {
     case '*': return a * b;
     case '/':
         if (!b) throw runtime_error("divided by 0!!!!!!");
+        if (a == INT_MIN && b == -1) throw runtime_error("integer overflow");
         return a / b;
     case '%':
         if (!b) throw runtime_error("divided by 0!!!!!!");
+        if (a == INT_MIN && b == -1) throw runtime_error("integer overflow");
         return a % b;
     default: throw runtime_error("unknown operator");
     }
 }
 
 /**
- * 中缀表达式转后缀表达式(逆波兰表示法)
- * 算法步骤：
- * 1. 遇到数字直接输出
- * 2. 遇到左括号压入栈中
- * 3. 遇到右括号，弹出栈中元素直到遇到左括号
- * 4. 遇到运算符，和栈顶运算符比较优先级：
- *    - 如果栈为空或栈顶为左括号，直接入栈
- *    - 否则将栈顶运算符弹出，直到遇到优先级更低的运算符
+ * 带位置的解析错误
+ * position 为出错记号在输入中的下标，便于指出错误所在
  */
-string to_suffix(string const &s) {
-    string res;  // 存储后缀表达式结果
-    ArrayStack<char> op;  // 运算符栈
-    
-    // 遍历中缀表达式的每个字符
-    for (int i = 0; i < (int)s.size(); ++i) {
-        if (isspace(s[i])) continue;  // 跳过空白字符
-        
-        // 处理数字
-        if (isdigit(s[i])) {
-            while (i < (int)s.size() && isdigit(s[i])) {
-                res += s[i++];  // 将连续的数字字符加入结果
+class ParseError : public runtime_error {
+public:
+    ParseError(string const &message, size_t position)
+        : runtime_error(message + " at position " + to_string(position)),
+          _position(position) {}
+
+    size_t position() const noexcept {
+        return _position;
+    }
+
+private:
+    size_t _position;
+};
+
+/**
+ * 记号类型
+ */
+enum class TokenKind : char {
+    NUMBER,    // 整数常量
+    VARIABLE,  // 变量名
+    OPERATOR,  // + - * / %
+    LPAREN,    // (
+    RPAREN,    // )
+    END,       // 输入结束
+};
+
+/**
+ * 记号
+ * text 直接引用输入中的字符，不做拷贝
+ */
+struct Token {
+    TokenKind kind;
+    string_view text;
+    size_t pos;
+};
+
+/**
+ * 词法分析器
+ * 在 string_view 上逐个切出记号，整个过程不分配内存
+ */
+class Tokenizer {
+public:
+    explicit Tokenizer(string_view s) : src(s), pos(0) {
+        advance();
+    }
+
+    /**
+     * 当前记号
+     */
+    Token const &peek() const noexcept {
+        return current;
+    }
+
+    /**
+     * 读入下一个记号
+     * @throws ParseError 遇到无法识别的字符时抛出异常
+     */
+    void advance() {
+        while (pos < src.size() &&
+               isspace(static_cast<unsigned char>(src[pos]))) {
+            pos++;
+        }
+        size_t start = pos;
+        if (pos == src.size()) {
+            current = Token{TokenKind::END, src.substr(pos, 0), pos};
+            return;
+        }
+        char c = src[pos];
+        TokenKind kind;
+        if (isdigit(static_cast<unsigned char>(c))) {
+            while (pos < src.size() &&
+                   isdigit(static_cast<unsigned char>(src[pos]))) {
+                pos++;
             }
-            res += ' ';  // 数字之后添加空格分隔
-            i--;  // 回退一个位置，因为for循环会自增
-        }
-        // 处理左括号
-        else if (s[i] == '(') {
-            op.push(s[i]);
-        }
-        // 处理右括号
-        else if (s[i] == ')') {
-            // 将栈中运算符弹出，直到遇到左括号
-            while (!op.empty() && op.top() != '(') {
-                res += op.top();
-                res += ' ';
-                op.pop();
+            kind = TokenKind::NUMBER;
+        } else if (isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            while (pos < src.size() &&
+                   (isalnum(static_cast<unsigned char>(src[pos])) ||
+                    src[pos] == '_')) {
+                pos++;
             }
-            if (!op.empty()) op.pop();  // 弹出左括号
-        }
-        // 处理运算符
-        else if (is_op(s[i])) {
-            // 将栈中优先级大于等于当前运算符的运算符弹出
-            while (!op.empty() && op.top() != '(' &&
-                   get_priority(op.top()) >= get_priority(s[i])) {
-                res += op.top();
-                res += ' ';
-                op.pop();
+            kind = TokenKind::VARIABLE;
+        } else if (is_op(c)) {
+            pos++;
+            kind = TokenKind::OPERATOR;
+        } else if (c == '(' || c == ')') {
+            pos++;
+            kind = c == '(' ? TokenKind::LPAREN : TokenKind::RPAREN;
+        } else {
+            throw ParseError(string("unexpected character '") + c + "'", pos);
+        }
+        current = Token{kind, src.substr(start, pos - start), start};
+    }
+
+private:
+    string_view src;
+    size_t pos;
+    Token current;
+};
+
+/**
+ * 语法树结点类型
+ */
+enum class NodeKind : char {
+    NUMBER,    // 整数常量
+    VARIABLE,  // 变量
+    NEGATE,    // 一元负号，操作数为 left
+    BINARY,    // 二元运算
+};
+
+/**
+ * 语法树结点
+ * 子结点用下标表示；text 引用输入中的数字或变量名
+ */
+struct AstNode {
+    NodeKind kind;
+    char op;
+    int value;
+    int left;
+    int right;
+    string_view text;
+};
+
+/**
+ * 语法树
+ * 结点按创建顺序存放，子结点总在父结点之前。解析器生成的树中
+ * 数组顺序就是后序遍历顺序，根是最后一个结点，后缀表达式可以
+ * 顺序扫描一遍生成，不需要递归；优化后子结点可能被多个结点共用
+ */
+struct Ast {
+    ArrayList<AstNode> nodes;
+    int root = -1;
+};
+
+/**
+ * Pratt 解析器
+ * 二元运算符的结合力取 get_priority，同级左结合；
+ * 一元负号结合力最强，"-2*3" 即 (-2)*3
+ */
+class Parser {
+public:
+    explicit Parser(string_view s) : tokens(s), nesting(0) {
+        // 每个结点至少对应一个字符，一般还隔着空格，按一半预留
+        ast.nodes.reserve(s.size() / 2 + 1);
+    }
+
+    /**
+     * 解析整个输入
+     * @throws ParseError 语法错误时抛出异常
+     */
+    Ast parse() {
+        ast.root = parse_expression(0);
+        Token const &tok = tokens.peek();
+        if (tok.kind != TokenKind::END) {
+            throw ParseError("unexpected '" + string(tok.text) + "'", tok.pos);
+        }
+        return std::move(ast);
+    }
+
+private:
+    // 括号和负号嵌套层数的上限，防止递归过深
+    static constexpr size_t MAX_NESTING = 1000;
+
+    Tokenizer tokens;
+    Ast ast;
+    size_t nesting;
+
+    int add(AstNode const &node) {
+        ast.nodes.push_back(node);
+        return static_cast<int>(ast.nodes.size()) - 1;
+    }
+
+    /**
+     * 解析优先级高于 min_priority 的运算构成的表达式
+     */
+    int parse_expression(int min_priority) {
+        int left = parse_operand();
+        while (true) {
+            Token const &tok = tokens.peek();
+            if (tok.kind != TokenKind::OPERATOR ||
+                get_priority(tok.text[0]) <= min_priority) {
+                return left;
             }
-            op.push(s[i]);
+            char op = tok.text[0];
+            tokens.advance();
+            int right = parse_expression(get_priority(op));
+            left = add(AstNode{NodeKind::BINARY, op, 0, left, right, {}});
         }
     }
-    
-    // 将栈中剩余运算符弹出
-    while (!op.empty()) {
-        res += op.top();
-        res += ' ';
-        op.pop();
+
+    /**
+     * 解析数字、变量、括号表达式或带负号的操作数
+     */
+    int parse_operand() {
+        Token tok = tokens.peek();
+        switch (tok.kind) {
+        case TokenKind::NUMBER: {
+            int value = 0;
+            auto result = from_chars(tok.text.data(),
+                                     tok.text.data() + tok.text.size(), value);
+            if (result.ec != errc()) {
+                throw ParseError("number out of range", tok.pos);
+            }
+            tokens.advance();
+            return add(AstNode{NodeKind::NUMBER, 0, value, -1, -1, tok.text});
+        }
+        case TokenKind::VARIABLE:
+            tokens.advance();
+            return add(AstNode{NodeKind::VARIABLE, 0, 0, -1, -1, tok.text});
+        case TokenKind::LPAREN: {
+            enter(tok);
+            tokens.advance();
+            int inner = parse_expression(0);
+            Token const &close = tokens.peek();
+            if (close.kind != TokenKind::RPAREN) {
+                throw ParseError("expected ')'", close.pos);
+            }
+            tokens.advance();
+            nesting--;
+            return inner;
+        }
+        case TokenKind::OPERATOR:
+            if (tok.text[0] == '-') {
+                enter(tok);
+                tokens.advance();
+                int operand = parse_operand();
+                nesting--;
+                return add(AstNode{NodeKind::NEGATE, '~', 0, operand, -1, {}});
+            }
+            break;
+        default: break;
+        }
+        if (tok.kind == TokenKind::END) {
+            throw ParseError("unexpected end of expression", tok.pos);
+        }
+        throw ParseError("expected operand before '" + string(tok.text) + "'",
+                         tok.pos);
+    }
+
+    void enter(Token const &tok) {
+        if (++nesting > MAX_NESTING) {
+            throw ParseError("expression nested too deeply", tok.pos);
+        }
+    }
+};
+
+/**
+ * 解析中缀表达式
+ * @param s 中缀表达式
+ * @return 语法树，其中的 text 引用 s，s 须在语法树使用期间保持有效
+ * @throws ParseError 语法错误时抛出异常
+ */
+Ast parse(string_view s) {
+    return Parser(s).parse();
+}
+
+/**
+ * 输出结点对应的记号；一元负号记作 ~，以便与减号区分
+ */
+void append_token(string &out, AstNode const &node) {
+    if (!out.empty()) {
+        out += ' ';
+    }
+    if (node.kind == NodeKind::NUMBER || node.kind == NodeKind::VARIABLE) {
+        out.append(node.text.data(), node.text.size());
+    } else {
+        out += node.op;
+    }
+}
+
+/**
+ * 中缀表达式转后缀表达式(逆波兰表示法)
+ * 语法树结点本身按后序排列，顺序输出即可
+ */
+string to_suffix(string const &s) {
+    Ast ast = parse(s);
+    string res;
+    res.reserve(s.size() + ast.nodes.size());
+    for (auto const &node: ast.nodes) {
+        append_token(res, node);
     }
-    
     return res;
 }
 
 /**
  * 中缀表达式转前缀表达式
- * 算法步骤：
- * 1. 将中缀表达式反转
- * 2. 交换左右括号
- * 3. 转换为后缀表达式
- * 4. 将结果再次反转得到前缀表达式
- */
-string to_prefix(string s) {
-    reverse(s.begin(), s.end());  // 反转字符串
-    // 交换左右括号
-    for (char &c: s) {
-        if (c == '(') c = ')';
-        else if (c == ')') c = '(';
-    }
-    string prefix = to_suffix(s);  // 转换为后缀表达式
-    reverse(prefix.begin(), prefix.end());  // 再次反转
-    return prefix;
+ * 用显式栈对语法树做先序遍历：先输出结点，再依次处理左、右子树
+ */
+string to_prefix(string const &s) {
+    Ast ast = parse(s);
+    string res;
+    res.reserve(s.size() + ast.nodes.size());
+    ArrayStack<int> pending;
+    pending.push(ast.root);
+    while (!pending.empty()) {
+        AstNode const &node = ast.nodes[pending.top()];
+        pending.pop();
+        append_token(res, node);
+        if (node.right >= 0) {
+            pending.push(node.right);
+        }
+        if (node.left >= 0) {
+            pending.push(node.left);
+        }
+    }
+    return res;
 }
 
 /**
- * 计算后缀表达式的值
- * 算法步骤：
- * 1. 遇到数字压入栈中
- * 2. 遇到运算符，弹出两个操作数进行计算，结果压回栈中
- * 3. 最后栈顶元素即为表达式的值
+ * 表达式优化器
+ * 按后序逐个处理语法树结点，子结点总是先于父结点完成，不需要递归：
+ * 1. 常量折叠：操作数都是常量的运算直接算出结果(除以 0 的保留到求值时报错)
+ * 2. 代数化简：x+0、x-0、x*1、x/1、-(-x) 等；x*0、x%1 只有在 x
+ *    不含除法(求值不会抛出异常)时才化简为 0
+ * 3. 哈希合并(hash-consing)：结构相同的结点只保留一个，
+ *    重复出现的子表达式在结果中是同一个结点，编译时只计算一次
+ * 加法和乘法的两个操作数按结点编号排序，x+y 与 y+x 也能合并
  */
-int eval_suffix(string const &s) {
-    ArrayStack<int> nums;  // 操作数栈
-    string token;
-    istringstream d(s);  // 用于分割字符串
-    
-    // 读取每个标记(数字或运算符)
-    while (d >> token) {
-        // 处理数字
-        if (isdigit(token[0])) {
-            nums.push(stoi(token));
-        }
-        // 处理运算符
-        else if (token.size() == 1 && is_op(token[0])) {
-            if (nums.size() < 2) {
-                throw runtime_error("Invalid expression");
+class Optimizer {
+public:
+    explicit Optimizer(Ast const &ast) : source(ast) {
+        size_t capacity = 16;
+        while (capacity < 2 * ast.nodes.size()) {
+            capacity *= 2;
+        }
+        buckets = ArrayList<int>(capacity, -1);
+        result.nodes.reserve(ast.nodes.size());
+        pure.reserve(ast.nodes.size());
+    }
+
+    /**
+     * 返回优化后的语法树，其中的 text 仍引用原输入
+     */
+    Ast run() {
+        ArrayList<int> mapped(source.nodes.size(), -1);
+        for (size_t i = 0; i < source.nodes.size(); i++) {
+            AstNode const &node = source.nodes[i];
+            switch (node.kind) {
+            case NodeKind::NUMBER:
+            case NodeKind::VARIABLE: mapped[i] = intern(node); break;
+            case NodeKind::NEGATE: mapped[i] = negate(mapped[node.left]); break;
+            case NodeKind::BINARY:
+                mapped[i] = binary(node.op, mapped[node.left],
+                                   mapped[node.right]);
+                break;
+            }
+        }
+        result.root = mapped[source.root];
+        return std::move(result);
+    }
+
+private:
+    Ast const &source;
+    Ast result;
+    ArrayList<int> buckets;  // 开放定址哈希表，存结点编号，-1 为空
+    ArrayList<char> pure;    // 结点求值是否一定不抛出异常
+
+    bool is_number(int n, int value) const {
+        AstNode const &node = result.nodes[n];
+        return node.kind == NodeKind::NUMBER && node.value == value;
+    }
+
+    int number(int value) {
+        return intern(AstNode{NodeKind::NUMBER, 0, value, -1, -1, {}});
+    }
+
+    int negate(int a) {
+        AstNode const &node = result.nodes[a];
+        // -INT_MIN 溢出，不折叠
+        if (node.kind == NodeKind::NUMBER && node.value != INT_MIN) {
+            return number(-node.value);
+        }
+        if (node.kind == NodeKind::NEGATE) {
+            return node.left;
+        }
+        return intern(AstNode{NodeKind::NEGATE, '~', 0, a, -1, {}});
+    }
+
+    /**
+     * 常量折叠：计算 a op b，除数为0或结果溢出时返回 false，
+     * 该运算保留到求值时进行
+     */
+    static bool fold(int a, int b, char op, int &out) {
+        switch (op) {
+        case '+': return !__builtin_add_overflow(a, b, &out);
+        case '-': return !__builtin_sub_overflow(a, b, &out);
+        case '*': return !__builtin_mul_overflow(a, b, &out);
+        case '/':
+        case '%':
+            // INT_MIN / -1 溢出，在 x86 上会触发 SIGFPE
+            if (b == 0 || (a == INT_MIN && b == -1)) {
+                return false;
+            }
+            out = op == '/' ? a / b : a % b;
+            return true;
+        default: return false;
+        }
+    }
+
+    int binary(char op, int a, int b) {
+        AstNode const &x = result.nodes[a];
+        AstNode const &y = result.nodes[b];
+        int folded;
+        if (x.kind == NodeKind::NUMBER && y.kind == NodeKind::NUMBER &&
+            fold(x.value, y.value, op, folded)) {
+            return number(folded);
+        }
+        switch (op) {
+        case '+':
+            if (is_number(a, 0)) return b;
+            if (is_number(b, 0)) return a;
+            break;
+        case '-':
+            if (is_number(b, 0)) return a;
+            if (is_number(a, 0)) return negate(b);
+            if (a == b && pure[a]) return number(0);
+            break;
+        case '*':
+            if (is_number(a, 1)) return b;
+            if (is_number(b, 1)) return a;
+            if ((is_number(a, 0) && pure[b]) || (is_number(b, 0) && pure[a])) {
+                return number(0);
+            }
+            break;
+        case '/':
+            if (is_number(b, 1)) return a;
+            break;
+        case '%':
+            // x % -1 在 x 为 INT_MIN 时会抛出异常，不化简
+            if (is_number(b, 1) && pure[a]) {
+                return number(0);
+            }
+            break;
+        }
+        if ((op == '+' || op == '*') && b < a) {
+            swap(a, b);
+        }
+        return intern(AstNode{NodeKind::BINARY, op, 0, a, b, {}});
+    }
+
+    static size_t hash(AstNode const &node) {
+        size_t h = static_cast<size_t>(node.kind) * 31 +
+                   static_cast<unsigned char>(node.op);
+        if (node.kind == NodeKind::VARIABLE) {
+            return h * 1000003 + std::hash<string_view>()(node.text);
+        }
+        h = h * 1000003 + static_cast<unsigned>(node.value);
+        h = h * 1000003 + static_cast<unsigned>(node.left);
+        h = h * 1000003 + static_cast<unsigned>(node.right);
+        return h ^ (h >> 17);
+    }
+
+    static bool same(AstNode const &a, AstNode const &b) {
+        return a.kind == b.kind && a.op == b.op && a.value == b.value &&
+               a.left == b.left && a.right == b.right &&
+               (a.kind != NodeKind::VARIABLE || a.text == b.text);
+    }
+
+    /**
+     * 查找结构相同的结点，没有则追加；返回结点编号
+     */
+    int intern(AstNode const &node) {
+        size_t mask = buckets.size() - 1;
+        size_t i = hash(node) & mask;
+        while (buckets[i] >= 0) {
+            if (same(result.nodes[buckets[i]], node)) {
+                return buckets[i];
             }
-            int b = nums.top(); nums.pop();
-            int a = nums.top(); nums.pop();
-            nums.push(calc(a, b, token[0]));
+            i = (i + 1) & mask;
+        }
+        AstNode stored = node;
+        if (stored.kind == NodeKind::NUMBER) {
+            stored.text = {};
         }
+        result.nodes.push_back(stored);
+        int index = static_cast<int>(result.nodes.size()) - 1;
+        bool safe = node.kind != NodeKind::BINARY ||
+                    (node.op != '/' && node.op != '%');
+        if (node.left >= 0) safe = safe && pure[node.left];
+        if (node.right >= 0) safe = safe && pure[node.right];
+        pure.push_back(safe);
+        buckets[i] = index;
+        return index;
     }
-    return nums.empty() ? 0 : nums.top();
+};
+
+/**
+ * 优化语法树，见 Optimizer
+ */
+Ast optimize(Ast const &ast) {
+    return Optimizer(ast).run();
 }
 
 /**
- * 直接计算中缀表达式的值
- * 实现方法：先转换为后缀表达式，再计算后缀表达式的值
+ * 字节码操作码
+ * 运算类操作码直接取运算符字符，可以原样交给 calc
+ */
+enum class OpCode : char {
+    PUSH = 0,  // 压入常数
+    LOAD = 1,  // 压入变量的值
+    NEG = '~', // 栈顶取反
+    STORE = 2, // 把栈顶复制到临时变量，不出栈
+    FETCH = 3, // 压入临时变量的值
+    ADD = '+',
+    SUB = '-',
+    MUL = '*',
+    DIV = '/',
+    MOD = '%',
+};
+
+/**
+ * 字节码指令
+ * PUSH 的 value 为常数，LOAD 的 value 为变量编号，
+ * STORE 和 FETCH 的 value 为临时变量编号
+ */
+struct Instruction {
+    OpCode op;
+    int value;
+};
+
+/**
+ * 编译后的表达式
+ * code 为后缀顺序的指令序列，max_depth 为求值时栈的最大深度，
+ * variables 按首次出现的顺序记录变量名，下标即变量编号，
+ * temps 为保存公共子表达式结果所需的临时变量个数
+ */
+struct Program {
+    ArrayList<Instruction> code;
+    size_t max_depth = 0;
+    size_t temps = 0;
+    ArrayList<string> variables;
+
+    /**
+     * 查找变量编号，不存在时登记为新变量
+     */
+    int variable(string const &name) {
+        for (size_t i = 0; i < variables.size(); i++) {
+            if (variables[i] == name) {
+                return static_cast<int>(i);
+            }
+        }
+        variables.push_back(name);
+        return static_cast<int>(variables.size() - 1);
+    }
+};
+
+/**
+ * 把一条指令追加到程序末尾，同时跟踪栈深度
+ * @throws runtime_error 运算符缺少操作数时抛出异常
+ */
+void emit(Program &program, size_t &depth, OpCode op, int value = 0) {
+    if (op == OpCode::PUSH || op == OpCode::LOAD || op == OpCode::FETCH) {
+        program.max_depth = max(program.max_depth, ++depth);
+    } else if (op == OpCode::NEG || op == OpCode::STORE) {
+        if (depth < 1) {
+            throw runtime_error("Invalid expression");
+        }
+    } else if (depth < 2) {
+        throw runtime_error("Invalid expression");
+    } else {
+        --depth;
+    }
+    program.code.push_back(Instruction{op, value});
+}
+
+/**
+ * 生成一个叶子或运算结点自身的指令
+ */
+void emit_node(Program &program, size_t &depth, AstNode const &node) {
+    switch (node.kind) {
+    case NodeKind::NUMBER:
+        emit(program, depth, OpCode::PUSH, node.value);
+        break;
+    case NodeKind::VARIABLE:
+        emit(program, depth, OpCode::LOAD, program.variable(string(node.text)));
+        break;
+    case NodeKind::NEGATE: emit(program, depth, OpCode::NEG); break;
+    case NodeKind::BINARY:
+        emit(program, depth, static_cast<OpCode>(node.op));
+        break;
+    }
+}
+
+/**
+ * 由优化后的语法树生成字节码
+ * 被多个结点共用的运算结点第一次计算后用 STORE 存入临时变量，
+ * 之后直接 FETCH。用显式栈做后序遍历，很长的运算链也不会栈溢出
+ */
+void emit_shared(Program &program, Ast const &ast) {
+    size_t count = ast.nodes.size();
+    // 统计每个结点被引用的次数，只统计从根可达的结点；
+    // 父结点编号总大于子结点，从根向前扫描一遍即可
+    ArrayList<int> uses(count, 0);
+    uses[ast.root] = 1;
+    for (int i = ast.root; i >= 0; i--) {
+        AstNode const &node = ast.nodes[i];
+        if (uses[i] == 0) continue;
+        if (node.left >= 0) uses[node.left]++;
+        if (node.right >= 0) uses[node.right]++;
+    }
+
+    ArrayList<int> temp(count, -1);  // 结点结果所在的临时变量
+    ArrayStack<Pair<int, bool>> pending;  // (结点, 子结点是否已展开)
+    size_t depth = 0;
+    pending.push(Pair(ast.root, false));
+    while (!pending.empty()) {
+        auto [n, expanded] = pending.top();
+        pending.pop();
+        AstNode const &node = ast.nodes[n];
+        if (temp[n] >= 0) {
+            emit(program, depth, OpCode::FETCH, temp[n]);
+        } else if (expanded || node.left < 0) {
+            emit_node(program, depth, node);
+            if (uses[n] > 1 && node.left >= 0) {
+                temp[n] = static_cast<int>(program.temps++);
+                emit(program, depth, OpCode::STORE, temp[n]);
+            }
+        } else {
+            pending.push(Pair(n, true));
+            if (node.right >= 0) pending.push(Pair(node.right, false));
+            pending.push(Pair(node.left, false));
+        }
+    }
+}
+
+/**
+ * 编译中缀表达式为字节码
+ * 数字在解析时转换一次，之后求值不再涉及任何字符串处理。
+ * 以字母或下划线开头的标识符是变量，求值时由调用者提供变量的值
  * @param s 中缀表达式字符串
+ * @param optimized 是否先做常量折叠、代数化简和公共子表达式合并；
+ *                  为 false 时按语法树原样顺序生成
+ * @return 编译后的程序
+ * @throws ParseError 语法错误时抛出异常
+ */
+Program compile(string_view s, bool optimized = true) {
+    Ast ast = parse(s);
+    Program program;
+    program.code.reserve(ast.nodes.size());
+    if (optimized) {
+        emit_shared(program, optimize(ast));
+        return program;
+    }
+    // 解析器生成的结点已按后序排列，顺序扫描即可
+    size_t depth = 0;  // 当前栈深度
+    for (auto const &node: ast.nodes) {
+        emit_node(program, depth, node);
+    }
+    return program;
+}
+
+/**
+ * 执行编译后的程序
+ * 每个线程复用同一个操作数栈，容量按 max_depth 预留，
+ * 因此求值过程中不做任何内存分配
+ * @param program compile 生成的程序
+ * @param values 各变量的值，按变量编号排列；没有变量时可以为空
  * @return 表达式计算结果
+ * @throws runtime_error 除数为0时抛出异常
+ * @throws invalid_argument 程序含有变量但没有给出变量值时抛出异常
  */
-int eval(string const &s) {
-    return eval_suffix(to_suffix(s));
+int evaluate(Program const &program, int const *values = nullptr) {
+    if (values == nullptr && !program.variables.empty()) {
+        throw invalid_argument("missing variable values");
+    }
+    thread_local ArrayStack<int> nums;
+    thread_local ArrayList<int> temps;
+    nums.clear();
+    nums.reserve(program.max_depth);
+    if (temps.size() < program.temps) {
+        temps = ArrayList<int>(program.temps, 0);
+    }
+    for (auto const &ins: program.code) {
+        if (ins.op == OpCode::PUSH) {
+            nums.push(ins.value);
+        } else if (ins.op == OpCode::LOAD) {
+            nums.push(values[ins.value]);
+        } else if (ins.op == OpCode::NEG) {
+            nums.top() = -nums.top();
+        } else if (ins.op == OpCode::STORE) {
+            temps.begin()[ins.value] = nums.top();
+        } else if (ins.op == OpCode::FETCH) {
+            nums.push(temps.begin()[ins.value]);
+        } else {
+            int b = nums.top();
+            nums.pop();
+            int &a = nums.top();
+            a = calc(a, b, static_cast<char>(ins.op));
+        }
+    }
+    return nums.top();
+}
+
+/**
+ * 对一段数据逐元素执行一种运算：dst[i] = a[i] op b[i]
+ * 每种运算一个独立的简单循环，编译器可以将加减乘向量化
+ * @throws runtime_error 除数中有0或有 INT_MIN 除以 -1 时抛出异常
+ */
+void calc_column(int *dst, int const *a, int const *b, size_t n, OpCode op) {
+    switch (op) {
+    case OpCode::ADD:
+        for (size_t i = 0; i < n; i++) dst[i] = a[i] + b[i];
+        break;
+    case OpCode::SUB:
+        for (size_t i = 0; i < n; i++) dst[i] = a[i] - b[i];
+        break;
+    case OpCode::MUL:
+        for (size_t i = 0; i < n; i++) dst[i] = a[i] * b[i];
+        break;
+    case OpCode::DIV:
+    case OpCode::MOD: {
+        // 先整段检查除数，除法循环内不再有分支
+        bool zero = false;
+        bool overflow = false;
+        for (size_t i = 0; i < n; i++) {
+            zero |= b[i] == 0;
+            overflow |= (a[i] == INT_MIN) & (b[i] == -1);
+        }
+        if (zero) throw runtime_error("divided by 0!!!!!!");
+        if (overflow) throw runtime_error("integer overflow");
+        if (op == OpCode::DIV) {
+            for (size_t i = 0; i < n; i++) dst[i] = a[i] / b[i];
+        } else {
+            for (size_t i = 0; i < n; i++) dst[i] = a[i] % b[i];
+        }
+        break;
+    }
+    default: throw runtime_error("unknown operator");
+    }
+}
+
+/**
+ * 批量求值：对每一行变量值计算一次表达式
+ * 按列执行而不是逐行执行：每次取 BATCH_CHUNK 行，
+ * 每条指令对整段数据做一次循环。栈上保存的是指向整段操作数的指针，
+ * 变量直接指向输入列，不做拷贝，只有常数和中间结果写入暂存区；
+ * 暂存区在栈各层之后为每个临时变量另留一段
+ * @param program compile 生成的程序
+ * @param columns 各变量的值，columns[k] 对应编号为 k 的变量
+ * @param out 结果，其长度即行数
+ * @throws invalid_argument 列数或列长度与程序不符时抛出异常
+ * @throws runtime_error 除数为0时抛出异常
+ */
+void evaluate_batch(Program const &program,
+                    ArrayList<ArrayList<int>> const &columns,
+                    ArrayList<int> &out) {
+    constexpr size_t BATCH_CHUNK = 1024;
+    size_t rows = out.size();
+    if (columns.size() != program.variables.size()) {
+        throw invalid_argument("column count does not match variables");
+    }
+    for (auto const &column: columns) {
+        if (column.size() != rows) {
+            throw invalid_argument("column length does not match output");
+        }
+    }
+
+    // 暂存区：栈的每一层一段，线程内复用
+    thread_local ArrayList<int> scratch;
+    size_t need = (program.max_depth + program.temps) * BATCH_CHUNK;
+    if (scratch.size() < need) {
+        scratch = ArrayList<int>(need, 0);
+    }
+    thread_local ArrayStack<int const *> operands;
+    operands.reserve(program.max_depth);
+
+    int *temps = scratch.begin() + program.max_depth * BATCH_CHUNK;
+    for (size_t first = 0; first < rows; first += BATCH_CHUNK) {
+        size_t n = min(BATCH_CHUNK, rows - first);
+        operands.clear();
+        for (auto const &ins: program.code) {
+            int *slot = scratch.begin() + operands.size() * BATCH_CHUNK;
+            if (ins.op == OpCode::PUSH) {
+                fill(slot, slot + n, ins.value);
+                operands.push(slot);
+            } else if (ins.op == OpCode::LOAD) {
+                operands.push(columns[ins.value].begin() + first);
+            } else if (ins.op == OpCode::STORE) {
+                copy(operands.top(), operands.top() + n,
+                     temps + ins.value * BATCH_CHUNK);
+            } else if (ins.op == OpCode::FETCH) {
+                operands.push(temps + ins.value * BATCH_CHUNK);
+            } else if (ins.op == OpCode::NEG) {
+                int const *a = operands.top();
+                operands.pop();
+                slot = scratch.begin() + operands.size() * BATCH_CHUNK;
+                for (size_t i = 0; i < n; i++) slot[i] = -a[i];
+                operands.push(slot);
+            } else {
+                int const *b = operands.top();
+                operands.pop();
+                int const *a = operands.top();
+                operands.pop();
+                // 结果写入 a 所在层的暂存区，a 与结果重叠也不影响逐元素运算
+                slot = scratch.begin() + operands.size() * BATCH_CHUNK;
+                calc_column(slot, a, b, n, ins.op);
+                operands.push(slot);
+            }
+        }
+        copy(operands.top(), operands.top() + n, out.begin() + first);
+    }
 }
 
 /**
- * 任务(进程)结构体
- * 用于模拟操作系统进程调度的基本数据结构
- * 包含进程的各项基本属性和时间信息
+ * 编译缓存
+ * 以规范化后的表达式文本为键缓存编译结果，容量满时淘汰最久未用的一项。
+ * 查找只加共享锁，多个线程可以同时命中；最近使用时间记在每项的
+ * 原子计数器里，命中时不需要独占锁，因此淘汰顺序是近似的 LRU
  */
-struct Task {
-    int id;          // 任务唯一标识符
-    int cpu_time;    // 任务需要的CPU执行时间
-    int submit_time; // 任务提交时间
-    int start_time;  // 任务开始执行时间
-    int end_time;    // 任务结束时间
-    int wait_time;   // 任务等待时间(开始时间-提交时间)
+class CompileCache {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+
+    /**
+     * @param capacity 最多缓存的表达式个数
+     * @throws invalid_argument 容量为0时抛出异常
+     */
+    explicit CompileCache(size_t capacity = DEFAULT_CAPACITY)
+        : _capacity(capacity),
+          tick(0),
+          hit_count(0),
+          miss_count(0) {
+        if (capacity == 0) {
+            throw invalid_argument("cache capacity must be positive");
+        }
+        entries.reserve(capacity + 1);
+    }
+
+    CompileCache(CompileCache const &) = delete;
+    CompileCache &operator=(CompileCache const &) = delete;
+
+    /**
+     * 取得表达式的编译结果，未命中时编译并放入缓存
+     * 编译在锁外进行，不会阻塞其他线程的查找
+     * @throws ParseError 语法错误时抛出异常，出错的表达式不会被缓存
+     */
+    shared_ptr<Program const> get(string_view expr) {
+        thread_local string key;  // 复用缓冲区，命中时不分配内存
+        normalize(expr, key);
+        {
+            shared_lock<shared_mutex> lock(mutex);
+            auto it = entries.find(key);
+            if (it != entries.end()) {
+                it->second.last_used.store(next_tick(), memory_order_relaxed);
+                hit_count.fetch_add(1, memory_order_relaxed);
+                return it->second.program;
+            }
+        }
+        miss_count.fetch_add(1, memory_order_relaxed);
+        auto program = make_shared<Program const>(compile(expr));
+
+        unique_lock<shared_mutex> lock(mutex);
+        auto [it, inserted] = entries.try_emplace(key);
+        if (inserted) {
+            it->second.program = std::move(program);
+            if (entries.size() > _capacity) {
+                evict_oldest(it->first);
+            }
+        }
+        it->second.last_used.store(next_tick(), memory_order_relaxed);
+        return it->second.program;
+    }
+
+    size_t hits() const noexcept {
+        return hit_count.load(memory_order_relaxed);
+    }
+
+    size_t misses() const noexcept {
+        return miss_count.load(memory_order_relaxed);
+    }
+
+    size_t size() const {
+        shared_lock<shared_mutex> lock(mutex);
+        return entries.size();
+    }
+
+    size_t capacity() const noexcept {
+        return _capacity;
+    }
+
+    void clear() {
+        unique_lock<shared_mutex> lock(mutex);
+        entries.clear();
+    }
 
     /**
-     * 任务构造函数
-     * @param i 任务ID
-     * @param c CPU时间
-     * @param s 提交时间
+     * 规范化表达式文本：去掉空白，只在两个数字或标识符字符之间
+     * 保留一个空格，避免 "1 2" 与 "12" 被当成同一个表达式
      */
-    Task(int i, int c, int s)
-        : id(i),
-          cpu_time(c),
-          submit_time(s),
-          start_time(0),
-          end_time(0),
-          wait_time(0) {}
+    static void normalize(string_view s, string &out) {
+        // 命中路径上每个字符都要判断，不调用依赖 locale 的 isspace/isalnum
+        auto is_space = [](char c) {
+            return c == ' ' || (c >= '\t' && c <= '\r');
+        };
+        auto is_word = [](char c) {
+            char lower = static_cast<char>(c | 0x20);
+            return (c >= '0' && c <= '9') || (lower >= 'a' && lower <= 'z') ||
+                   c == '_';
+        };
+        out.resize(s.size());  // 规范化后不会变长
+        size_t n = 0;
+        bool space = false;
+        for (char c: s) {
+            if (is_space(c)) {
+                space = true;
+                continue;
+            }
+            if (space && n > 0 && is_word(out[n - 1]) && is_word(c)) {
+                out[n++] = ' ';
+            }
+            space = false;
+            out[n++] = c;
+        }
+        out.resize(n);
+    }
+
+private:
+    struct Entry {
+        shared_ptr<Program const> program;
+        atomic<uint64_t> last_used{0};
+    };
+
+    size_t _capacity;
+    unordered_map<string, Entry> entries;
+    mutable shared_mutex mutex;
+    atomic<uint64_t> tick;
+    atomic<size_t> hit_count;
+    atomic<size_t> miss_count;
+
+    uint64_t next_tick() noexcept {
+        return tick.fetch_add(1, memory_order_relaxed) + 1;
+    }
 
     /**
-     * 默认构造函数
-     * 所有属性初始化为0
+     * 淘汰最近使用时间最早的一项(不淘汰刚插入的 keep)
+     * 只在未命中时调用，线性扫描的开销与编译相比可以忽略
      */
-    Task()
-        : id(0),
-          cpu_time(0),
-          submit_time(0),
-          start_time(0),
-          end_time(0),
-          wait_time(0) {}
+    void evict_oldest(string const &keep) {
+        auto oldest = entries.end();
+        uint64_t oldest_tick = UINT64_MAX;
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            uint64_t used = it->second.last_used.load(memory_order_relaxed);
+            if (it->first != keep && used < oldest_tick) {
+                oldest = it;
+                oldest_tick = used;
+            }
+        }
+        if (oldest != entries.end()) {
+            entries.erase(oldest);
+        }
+    }
 };
 
 /**
- * 计算任务列表的平均等待时间
- * 算法步骤：
- * 1. 按照任务顺序模拟执行过程
- * 2. 计算每个任务的等待时间
- * 3. 返回平均等待时间
- * @param tasks 任务列表
- * @return 平均等待时间
+ * eval 使用的全局编译缓存
  */
-double average_waiting_time(ArrayList<Task> &tasks) {
-    int current_time = 0;  // 当前系统时间
-    double total_wait_time = 0;  // 总等待时间
-    
-    for (auto &task: tasks) {
-        // 更新当前时间(考虑任务提交时间)
-        current_time = max(current_time, task.submit_time);
-        task.start_time = current_time;  // 设置开始时间
-        task.end_time = current_time + task.cpu_time;  // 计算结束时间
-        task.wait_time = task.start_time - task.submit_time;  // 计算等待时间
-        total_wait_time += task.wait_time;  // 累加等待时间
-        current_time = task.end_time;  // 更新当前时间
+CompileCache &compile_cache() {
+    static CompileCache cache;
+    return cache;
+}
+
+/**
+ * 直接计算中缀表达式的值
+ * 实现方法：经编译缓存取得字节码再执行，相同的表达式只编译一次
+ * @param s 中缀表达式字符串
+ * @return 表达式计算结果
+ */
+int eval(string const &s) {
+    return evaluate(*compile_cache().get(s));
+}
+
+/**
+ * 生成随机操作数：数字、变量、括号表达式或带负号的操作数
+ * 嵌套深度不超过 4 层；variables 为 false 时不生成变量
+ */
+void generate_chain(string &out, mt19937 &rng, int depth, size_t terms,
+                    bool variables = false);
+
+void generate_operand(string &out, mt19937 &rng, int depth,
+                      bool variables = false) {
+    unsigned k = rng() % 10;
+    if (k == 0 && depth < 4) {
+        out += '(';
+        generate_chain(out, rng, depth + 1, 2 + rng() % 4, variables);
+        out += ')';
+    } else if (k == 1 && depth < 4) {
+        out += '-';
+        generate_operand(out, rng, depth + 1, variables);
+    } else if (k < 5 && variables) {
+        out += "abcd"[rng() % 4];
+    } else {
+        out += to_string(rng() % 1000);
     }
-    
-    return total_wait_time / tasks.size();  // 返回平均等待时间
 }
 
 /**
- * 最短作业优先(SJF)调度算法
- * 算法原理：
- * 1. 将任务按CPU执行时间从小到大排序
- * 2. 按排序后的顺序执行任务
- * 特点：
- * - 最小化平均等待时间
- * - 可能导致长作业饥饿
- * @param tasks 任务列表
- * @return 平均等待时间
+ * 生成由 terms 个操作数组成的运算链
+ * 除数和模数总是 1~9 的常数，不会出现除以 0
  */
-double SJF(ArrayList<Task> &tasks) {
-    // 按CPU时间排序(lambda表达式比较)
-    sort(tasks.begin(), tasks.end(),
-         [](Task const &a, Task const &b) { return a.cpu_time < b.cpu_time; });
-    return average_waiting_time(tasks);
+void generate_chain(string &out, mt19937 &rng, int depth, size_t terms,
+                    bool variables) {
+    static char const ops[] = "+-*/%";
+    generate_operand(out, rng, depth, variables);
+    for (size_t i = 1; i < terms; i++) {
+        char op = ops[rng() % 5];
+        out += ' ';
+        out += op;
+        out += ' ';
+        if (op == '/' || op == '%') {
+            out += to_string(1 + rng() % 9);
+        } else {
+            generate_operand(out, rng, depth, variables);
+        }
+    }
 }
 
 /**
- * 先来先服务(FCFS)调度算法
- * 算法原理：
- * 1. 按任务提交时间排序
- * 2. 相同提交时间的按任务ID排序
- * 3. 按排序后的顺序执行任务
- * 特点：
- * - 实现简单公平
- * - 对短作业不利
- * @param tasks 任务列表
- * @return 平均等待时间
+ * 生成约 bytes 字节的随机表达式
  */
-double FCFS(ArrayList<Task> &tasks) {
-    // 先按提交时间排序，时间相同则按ID排序
-    sort(tasks.begin(), tasks.end(), [](Task const &a, Task const &b) {
-        if (a.submit_time == b.submit_time) {
-            return a.id < b.id;
+string generate_expression(size_t bytes, mt19937 &rng) {
+    string out;
+    while (out.size() < bytes) {
+        if (!out.empty()) {
+            out += " + ";
         }
-        return a.submit_time < b.submit_time;
-    });
-    return average_waiting_time(tasks);
+        generate_chain(out, rng, 0, 8);
+    }
+    return out;
+}
+
+/**
+ * 重复执行 f 至少 0.2 秒，返回每次的平均耗时(秒)
+ */
+template <typename F>
+double measure(F const &f) {
+    using clock = chrono::steady_clock;
+    size_t runs = 0;
+    auto start = clock::now();
+    double elapsed = 0;
+    do {
+        f();
+        runs++;
+        elapsed = chrono::duration<double>(clock::now() - start).count();
+    } while (elapsed < 0.2);
+    return elapsed / runs;
+}
+
+/**
+ * 解析性能测试
+ * 在生成的大表达式上测量解析、前缀/后缀转换和编译的吞吐量，
+ * 再比较逐次解析求值与编译一次后反复求值的速度，
+ * 以及优化对含大量重复项的公式的效果
+ * @param kib 生成表达式的大小(KiB)
+ */
+void parse_benchmark(size_t kib) {
+    mt19937 rng(2024);
+    string expr = generate_expression(kib << 10, rng);
+    double mib = expr.size() / double(1 << 20);
+    size_t sink = 0;  // 防止结果被优化掉
+    auto report = [&](char const *name, double seconds) {
+        cout << name << ": " << mib / seconds << " MiB/s\n";
+    };
+    cout << "表达式大小: " << expr.size() << " 字节, 结点数: "
+         << parse(expr).nodes.size() << '\n';
+    report("解析", measure([&] { sink += parse(expr).nodes.size(); }));
+    report("后缀", measure([&] { sink += to_suffix(expr).size(); }));
+    report("前缀", measure([&] { sink += to_prefix(expr).size(); }));
+    report("编译", measure([&] { sink += compile(expr, false).code.size(); }));
+    report("编译+优化", measure([&] { sink += compile(expr).code.size(); }));
+    Program program = compile(expr, false);
+    report("求值(未优化)", measure([&] { sink += evaluate(program); }));
+
+    string formula = generate_expression(64, rng);
+    Program compiled = compile(formula);
+    double each = measure([&] { sink += evaluate(compile(formula)); });
+    double cached = measure([&] { sink += eval(formula); });
+    double fast = measure([&] { sink += evaluate(compiled); });
+    cout << "短表达式 " << formula << '\n'
+         << "  每次编译: " << 1e-6 / each << " M次/s, eval(缓存): "
+         << 1e-6 / cached << " M次/s, 编译后 evaluate: " << 1e-6 / fast
+         << " M次/s\n"
+         << "  缓存命中 " << compile_cache().hits() << ", 未命中 "
+         << compile_cache().misses() << '\n';
+
+    // 由 8 个带变量的项随机重复组成的公式
+    string terms[8];
+    for (auto &term: terms) {
+        generate_chain(term, rng, 1, 4, true);
+    }
+    string repeated;
+    for (int i = 0; i < 200; i++) {
+        repeated += i == 0 ? "(" : " + (";
+        repeated += terms[rng() % 8];
+        repeated += ')';
+    }
+    Program plain = compile(repeated, false);
+    Program optimized = compile(repeated);
+    ArrayList<int> values(optimized.variables.size(), 7);
+    double slow = measure([&] { sink += evaluate(plain, values.begin()); });
+    double quick =
+        measure([&] { sink += evaluate(optimized, values.begin()); });
+    cout << "重复项公式: 指令数 " << plain.code.size() << " -> "
+         << optimized.code.size() << ", 临时变量 " << optimized.temps
+         << ", 求值 " << 1e-6 / slow << " -> " << 1e-6 / quick << " M次/s\n";
+    cout << "(校验值 " << sink % 10 << ")\n";
 }
 
 /**
  * 打印任务调度结果
- * 显示每个任务的详细信息和平均等待时间
+ * 按完成顺序显示每个任务的详细信息和汇总统计
  * @param tasks 任务列表
- * @param schedule_type 调度算法类型
+ * @param result 一种调度策略的结果
  */
 void print_task_schedule(ArrayList<Task> const &tasks,
-                         string const &schedule_type) {
-    double avg_wait = 0;
+                         PolicyResult const &result) {
+    Schedule const &schedule = result.schedule;
+    cout << "\n== " << result.name << " ==\n";
     // 打印每个任务的详细信息
-    for (auto const &task: tasks) {
-        avg_wait += task.wait_time;
-        cout << "Task " << task.id 
-             << ": Start=" << task.start_time
-             << ", Submit=" << task.submit_time 
-             << ", CPU=" << task.cpu_time
-             << ", End=" << task.end_time 
-             << ", Wait=" << task.wait_time
-             << '\n';
-    }
-    // 打印平均等待时间
-    cout << "Average Wait Time: " << avg_wait / tasks.size() << "\n\n";
+    for (uint32_t i: schedule.order) {
+        cout << "Task " << tasks[i].id 
+             << ": Start=" << schedule.start[i]
+             << ", Submit=" << tasks[i].submit_time 
+             << ", CPU=" << tasks[i].cpu_time
+             << ", End=" << schedule.end[i] 
+             << ", Wait=" << schedule.wait(tasks, i)
+             << ", Turnaround=" << schedule.turnaround(tasks, i);
+        if (!schedule.core.empty()) {
+            cout << ", Core=" << schedule.core[i];
+        }
+        cout << '\n';
+    }
+    // 打印汇总统计
+    ScheduleStats stats = summarize(tasks, schedule);
+    cout << "Average Wait Time: " << stats.average_wait
+         << "\nAverage Turnaround Time: " << stats.average_turnaround
+         << "\nMax Wait Time: " << stats.max_wait
+         << "\nMakespan: " << stats.makespan << "\n";
+    if (result.cores > 0) {
+        MultiCoreStats core_stats =
+            summarize_cores(tasks, schedule, result.cores);
+        cout << "Utilization: " << core_stats.utilization * 100 << "%"
+             << "\nP50 Wait Time: " << core_stats.p50_wait
+             << "\nP99 Wait Time: " << core_stats.p99_wait
+             << "\nMigrations: " << core_stats.migrations << "\n";
+    }
+    cout << '\n';
+}
+
+/**
+ * 打印各策略的比较表，每种策略一行
+ * @param tasks 任务列表
+ * @param results 各策略的结果
+ */
+void print_policy_table(ArrayList<Task> const &tasks,
+                        ArrayList<PolicyResult> const &results) {
+    cout << left << setw(24) << "policy" << right << setw(14) << "avg wait"
+         << setw(14) << "avg turn" << setw(12) << "max wait" << setw(12)
+         << "makespan" << setw(8) << "util%" << setw(10) << "p99 wait"
+         << setw(10) << "migrate" << setw(10) << "sim s" << '\n';
+    for (auto const &result: results) {
+        ScheduleStats stats = summarize(tasks, result.schedule);
+        cout << left << setw(24) << result.name << right << fixed
+             << setprecision(1) << setw(14) << stats.average_wait << setw(14)
+             << stats.average_turnaround << setw(12) << stats.max_wait
+             << setw(12) << stats.makespan;
+        if (result.cores > 0) {
+            MultiCoreStats core_stats =
+                summarize_cores(tasks, result.schedule, result.cores);
+            cout << setw(8) << core_stats.utilization * 100 << setw(10)
+                 << core_stats.p99_wait << setw(10) << core_stats.migrations;
+        } else {
+            cout << setw(8) << "-" << setw(10) << "-" << setw(10) << "-";
+        }
+        cout << setw(10) << setprecision(3) << result.seconds << '\n';
+    }
+    cout.unsetf(ios::floatfield);
+}
+
+/**
+ * 读入时间片和核数，读取失败或不合法时使用默认值
+ * @param quantum 时间片
+ * @param cores 核数
+ */
+void read_schedule_options(int &quantum, size_t &cores) {
+    cout << "请输入时间片:";
+    if (!(cin >> quantum) || quantum <= 0) {
+        quantum = DEFAULT_QUANTUM;
+    }
+    cout << "请输入核数:";
+    if (!(cin >> cores) || cores == 0) {
+        cores = DEFAULT_CORES;
+    }
 }
 
 /**
@@ -327,7 +1288,8 @@ void print_task_schedule(ArrayList<Task> const &tasks,
  * 2. 进程调度模拟
  */
 int main() {
-    cout << "输入: 0: 表达式, 1: 任务调度\n";
+    cout << "输入: 0: 表达式, 1: 任务调度, 2: 解析性能测试, "
+            "3: 调度轨迹比较\n";
     int n;
     cin >> n;
     cin.ignore();  // 清除输入缓冲区
@@ -336,9 +1298,35 @@ int main() {
     if (n == 0) {
         string expr;
         getline(cin, expr);  // 读取表达式
-        cout << "前缀：" << to_prefix(expr) << '\n';  // 转换并显示前缀表达式
-        cout << "后缀：" << to_suffix(expr) << '\n';  // 转换并显示后缀表达式
-        cout << expr << " = " << eval(expr);  // 计算并显示结果
+        try {
+            string prefix = to_prefix(expr);  // 转换为前缀表达式
+            string suffix = to_suffix(expr);  // 转换为后缀表达式
+            cout << "前缀：" << prefix << '\n';
+            cout << "后缀：" << suffix << '\n';
+            int value = eval(expr);  // 先计算，出错时不输出半行结果
+            cout << expr << " = " << value;
+        } catch (ParseError const &e) {
+            // 在出错位置下方标出 ^
+            cout << expr << '\n' << string(e.position(), ' ') << "^ "
+                 << e.what() << '\n';
+            return 1;
+        } catch (invalid_argument const &) {
+            cout << "表达式含有变量，无法直接求值\n";
+            return 1;
+        } catch (runtime_error const &e) {
+            // 除数为0、整数溢出等求值错误
+            cout << "求值错误：" << e.what() << '\n';
+            return 1;
+        }
+        return 0;
+    }
+
+    // 解析性能测试
+    if (n == 2) {
+        cout << "请输入表达式大小(KiB):";
+        size_t kib;
+        cin >> kib;
+        parse_benchmark(kib);
         return 0;
     }
     
@@ -355,19 +1343,50 @@ int main() {
             tasks.push_back(Task(id, cpu, submit));
         }
 
-        // 创建任务列表副本用于不同调度算法
-        ArrayList<Task> fcfs_tasks = tasks;
-        ArrayList<Task> sjf_tasks = tasks;
-
-        // 执行并显示FCFS调度结果
-        cout << "\n== First Come First Serve (FCFS) ==\n";
-        FCFS(fcfs_tasks);
-        print_task_schedule(fcfs_tasks, "FCFS");
+        // 时间片用于RR和MLFQ，核数用于多核模拟
+        int quantum;
+        size_t cores;
+        read_schedule_options(quantum, cores);
+        ArrayList<PolicyResult> results = run_policies(tasks, quantum, cores);
+        for (auto const &result: results) {
+            print_task_schedule(tasks, result);
+        }
+        return 0;
+    }
 
-        // 执行并显示SJF调度结果
-        cout << "\n== Shortest Job First (SJF) ==\n";
-        SJF(sjf_tasks);
-        print_task_schedule(sjf_tasks, "SJF");
+    // 从文件读入任务轨迹，并行运行全部策略后输出比较表
+    if (n == 3) {
+        cout << "请输入轨迹文件:";
+        string path;
+        getline(cin, path);
+        ifstream in(path, ios::binary);
+        if (!in) {
+            cout << "无法打开 " << path << '\n';
+            return 1;
+        }
+        int quantum;
+        size_t cores;
+        read_schedule_options(quantum, cores);
+        try {
+            auto start = chrono::steady_clock::now();
+            ArrayList<Task> tasks = load_trace(in);
+            double seconds = chrono::duration<double>(
+                                 chrono::steady_clock::now() - start)
+                                 .count();
+            cout << "\n读入 " << tasks.size() << " 个任务, " << seconds
+                 << " s\n";
+            start = chrono::steady_clock::now();
+            ArrayList<PolicyResult> results =
+                run_policies(tasks, quantum, cores);
+            seconds = chrono::duration<double>(chrono::steady_clock::now() -
+                                               start)
+                          .count();
+            print_policy_table(tasks, results);
+            cout << "并行模拟总耗时 " << seconds << " s\n";
+        } catch (exception const &e) {
+            cout << e.what() << '\n';
+            return 1;
+        }
     } else {
         cout << "输入错误\n";
     }
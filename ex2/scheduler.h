@@ -0,0 +1,712 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "../MyDS/arraylist.h"
+#include "../MyDS/arraystack.h"
+#include "../MyDS/circularqueue.h"
+#include "../MyDS/heap.h"
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * 任务(进程)结构体
+ * 用于模拟操作系统进程调度的输入数据，模拟过程中只读，
+ * 各调度算法的结果另存于 Schedule 中
+ */
+struct Task {
+    int id;          // 任务唯一标识符
+    int cpu_time;    // 任务需要的CPU执行时间
+    int submit_time; // 任务提交时间
+
+    /**
+     * 任务构造函数
+     * @param i 任务ID
+     * @param c CPU时间
+     * @param s 提交时间
+     */
+    Task(int i, int c, int s) : id(i), cpu_time(c), submit_time(s) {}
+
+    /**
+     * 默认构造函数
+     * 所有属性初始化为0
+     */
+    Task() : id(0), cpu_time(0), submit_time(0) {}
+};
+
+/**
+ * 一次调度的结果，各数组按任务在输入中的下标存放。
+ * 等待时间和周转时间由时刻和任务属性算出，不单独存储
+ */
+struct Schedule {
+    ArrayList<uint32_t> order;  // 按完成顺序排列的任务下标
+    ArrayList<long long> start; // 首次执行时刻
+    ArrayList<long long> end;   // 完成时刻
+    ArrayList<uint16_t> core;   // 执行任务的核，单核调度时为空
+    size_t migrations;          // 被其他核窃取执行的任务数
+
+    explicit Schedule(size_t n = 0)
+        : order(n),
+          start(n, 0),
+          end(n, 0),
+          migrations(0) {}
+
+    // 周转时间(结束时间-提交时间)
+    long long turnaround(ArrayList<Task> const &tasks, size_t i) const {
+        return end[i] - tasks[i].submit_time;
+    }
+
+    // 等待时间：周转时间减去执行时间，对抢占式调度即在就绪队列中的总时间
+    long long wait(ArrayList<Task> const &tasks, size_t i) const {
+        return turnaround(tasks, i) - tasks[i].cpu_time;
+    }
+};
+
+/**
+ * 带输入下标的任务副本。模拟时按值放在堆和数组中，
+ * 比较不必回到输入数组随机访问，结果按下标写回 Schedule
+ */
+struct Job {
+    Task task;
+    uint32_t index;
+};
+
+// 未指定时间片时 RR 和 MLFQ 使用的默认值
+constexpr int DEFAULT_QUANTUM = 4;
+
+// 未指定核数时多核模拟使用的默认值
+constexpr size_t DEFAULT_CORES = 4;
+
+/**
+ * 调度结果的汇总统计
+ */
+struct ScheduleStats {
+    double average_wait;       // 平均等待时间
+    double average_turnaround; // 平均周转时间
+    long long max_wait;        // 最长等待时间
+    long long makespan;        // 最后一个任务的结束时间
+};
+
+/**
+ * 到达顺序：按提交时间，相同时按ID
+ */
+inline bool arrives_before(Task const &a, Task const &b) {
+    if (a.submit_time != b.submit_time) {
+        return a.submit_time < b.submit_time;
+    }
+    return a.id < b.id;
+}
+
+/**
+ * 到达顺序的下标排列，各调度策略只读共享。
+ * 同一份任务列表上运行多种策略时只需求一次，见 run_policies；
+ * 各策略不带该参数的重载自己求一次
+ * @param tasks 任务列表
+ * @return 任务下标，按提交时间、再按ID排序
+ * @throws std::length_error 任务数超出下标范围
+ */
+inline ArrayList<uint32_t> arrival_order(ArrayList<Task> const &tasks) {
+    if (tasks.size() > UINT32_MAX) {
+        throw std::length_error("too many tasks");
+    }
+    // 带上任务一起排序，比较时不必回到输入数组随机访问
+    ArrayList<Job> jobs(tasks.size());
+    for (size_t i = 0; i < tasks.size(); i++) {
+        jobs.push_back(Job{tasks[i], static_cast<uint32_t>(i)});
+    }
+    std::sort(jobs.begin(), jobs.end(), [](Job const &a, Job const &b) {
+        return arrives_before(a.task, b.task);
+    });
+    ArrayList<uint32_t> order(tasks.size());
+    for (Job const &job: jobs) {
+        order.push_back(job.index);
+    }
+    return order;
+}
+
+/**
+ * 检查到达顺序与任务列表是否对应
+ * @throws std::invalid_argument 长度不同
+ */
+inline void check_arrival_order(ArrayList<Task> const &tasks,
+                                ArrayList<uint32_t> const &order) {
+    if (order.size() != tasks.size()) {
+        throw std::invalid_argument("arrival order does not match tasks");
+    }
+}
+
+/**
+ * 汇总一次调度的结果
+ * @param tasks 任务列表
+ * @param schedule 该任务列表的调度结果
+ * @return 汇总统计，任务列表为空时各项为0
+ */
+inline ScheduleStats summarize(ArrayList<Task> const &tasks,
+                               Schedule const &schedule) {
+    ScheduleStats stats = {0, 0, 0, 0};
+    if (tasks.empty()) {
+        return stats;
+    }
+    long long total_wait = 0;
+    long long total_turnaround = 0;
+    for (size_t i = 0; i < tasks.size(); i++) {
+        long long wait = schedule.wait(tasks, i);
+        total_wait += wait;
+        total_turnaround += schedule.turnaround(tasks, i);
+        stats.max_wait = std::max(stats.max_wait, wait);
+        stats.makespan = std::max(stats.makespan, schedule.end[i]);
+    }
+    stats.average_wait = static_cast<double>(total_wait) / tasks.size();
+    stats.average_turnaround =
+        static_cast<double>(total_turnaround) / tasks.size();
+    return stats;
+}
+
+/**
+ * 非抢占式调度的离散事件模拟
+ * 任务按到达顺序排好，已到达的任务放在按调度策略排序的就绪堆中。
+ * 每当 CPU 空闲，先把已到达的任务移入就绪堆，再取出策略认为最优先的
+ * 任务执行到结束；就绪堆为空时时间直接跳到下一个任务的提交时间。
+ * 每个任务进出堆各一次，总计 O(n log n)
+ * @param tasks 任务列表
+ * @param order 到达顺序，见 arrival_order
+ * @param before 策略顺序，before(a, b) 为真表示 a 应先于 b 执行
+ * @return 调度结果
+ * @throws std::invalid_argument 到达顺序与任务列表不对应
+ */
+template <typename Before>
+Schedule simulate(ArrayList<Task> const &tasks,
+                  ArrayList<uint32_t> const &order, Before before) {
+    check_arrival_order(tasks, order);
+    size_t n = tasks.size();
+    Schedule schedule(n);
+    auto first = [&before](Job const &a, Job const &b) {
+        return before(a.task, b.task);
+    };
+    Heap<Job, decltype(first)> ready(first);
+
+    long long current_time = 0;
+    size_t next = 0;
+    while (next < n || !ready.empty()) {
+        // CPU 空闲且没有就绪任务：跳到下一个任务到达的时刻
+        if (ready.empty()) {
+            long long arrival = tasks[order[next]].submit_time;
+            current_time = std::max(current_time, arrival);
+        }
+        while (next < n && tasks[order[next]].submit_time <= current_time) {
+            uint32_t index = order[next++];
+            ready.push(Job{tasks[index], index});
+        }
+        Job job = ready.top();
+        ready.pop();
+        schedule.start[job.index] = current_time;
+        current_time += job.task.cpu_time;
+        schedule.end[job.index] = current_time;
+        schedule.order.push_back(job.index);
+    }
+    return schedule;
+}
+
+/**
+ * 最短作业优先(SJF)调度算法(非抢占)
+ * 算法原理：
+ * 1. CPU 空闲时，在已经到达的任务中选择CPU时间最短的执行
+ * 2. CPU时间相同的按提交时间、再按ID先后
+ * 特点：
+ * - 最小化平均等待时间
+ * - 可能导致长作业饥饿
+ * @param tasks 任务列表
+ * @param order 到达顺序，见 arrival_order
+ * @return 调度结果
+ */
+inline Schedule SJF(ArrayList<Task> const &tasks,
+                    ArrayList<uint32_t> const &order) {
+    return simulate(tasks, order, [](Task const &a, Task const &b) {
+        if (a.cpu_time != b.cpu_time) {
+            return a.cpu_time < b.cpu_time;
+        }
+        if (a.submit_time != b.submit_time) {
+            return a.submit_time < b.submit_time;
+        }
+        return a.id < b.id;
+    });
+}
+
+inline Schedule SJF(ArrayList<Task> const &tasks) {
+    return SJF(tasks, arrival_order(tasks));
+}
+
+/**
+ * 先来先服务(FCFS)调度算法
+ * 算法原理：
+ * 1. 按任务提交时间先后执行
+ * 2. 相同提交时间的按任务ID排序
+ * 特点：
+ * - 实现简单公平
+ * - 对短作业不利
+ * @param tasks 任务列表
+ * @param order 到达顺序，见 arrival_order
+ * @return 调度结果
+ */
+inline Schedule FCFS(ArrayList<Task> const &tasks,
+                     ArrayList<uint32_t> const &order) {
+    return simulate(tasks, order, arrives_before);
+}
+
+inline Schedule FCFS(ArrayList<Task> const &tasks) {
+    return FCFS(tasks, arrival_order(tasks));
+}
+
+/**
+ * 抢占式调度的公共部分：只读的任务列表和到达顺序、
+ * 各任务的剩余执行时间，以及调度结果。任务以它在输入中的下标表示
+ */
+class PreemptiveRun {
+public:
+    /**
+     * @throws std::invalid_argument 到达顺序与任务列表不对应
+     */
+    PreemptiveRun(ArrayList<Task> const &tasks,
+                  ArrayList<uint32_t> const &order)
+        : tasks(tasks),
+          order(order),
+          remaining(tasks.size(), 0),
+          schedule(tasks.size()),
+          next(0),
+          now(0) {
+        check_arrival_order(tasks, order);
+        for (size_t i = 0; i < tasks.size(); i++) {
+            remaining[i] = tasks[i].cpu_time;
+            schedule.start[i] = -1;
+        }
+    }
+
+    bool done() const {
+        return schedule.order.size() == tasks.size();
+    }
+
+    // 还有任务未到达
+    bool has_arrival() const {
+        return next < order.size();
+    }
+
+    long long next_arrival() const {
+        return tasks[order[next]].submit_time;
+    }
+
+    // 取出下一个已到达(提交时间不晚于当前时刻)的任务，没有时返回 false
+    bool arrive(uint32_t &job) {
+        if (!has_arrival() || next_arrival() > now) {
+            return false;
+        }
+        job = order[next++];
+        return true;
+    }
+
+    Task const &task(uint32_t job) const {
+        return tasks[job];
+    }
+
+    long long time() const {
+        return now;
+    }
+
+    // 就绪队列为空时，时间跳到下一个任务到达的时刻
+    void idle() {
+        now = std::max(now, next_arrival());
+    }
+
+    long long &left(uint32_t job) {
+        return remaining[job];
+    }
+
+    // 执行 job 一段时间 slice，第一次执行时记下开始时间
+    void run(uint32_t job, long long slice) {
+        if (schedule.start[job] < 0) {
+            schedule.start[job] = now;
+        }
+        now += slice;
+        remaining[job] -= slice;
+        if (remaining[job] == 0) {
+            schedule.end[job] = now;
+            schedule.order.push_back(job);
+        }
+    }
+
+    Schedule result() {
+        return std::move(schedule);
+    }
+
+private:
+    ArrayList<Task> const &tasks;
+    ArrayList<uint32_t> const &order;
+    ArrayList<long long> remaining;
+    Schedule schedule;
+    size_t next;
+    long long now; // 当前时刻
+};
+
+/**
+ * 最短剩余时间优先(SRTF)调度算法(抢占式 SJF)
+ * 算法原理：
+ * 1. 就绪任务按剩余执行时间放在堆中，总是执行剩余时间最短的任务
+ * 2. 运行中的任务一直执行到结束或下一个任务到达；
+ *    新到达的任务剩余时间更短时抢占当前任务
+ * 事件只有到达和完成两种，每个事件至多一次堆操作，总计 O(n log n)
+ * @param tasks 任务列表
+ * @param order 到达顺序，见 arrival_order
+ * @return 调度结果
+ */
+inline Schedule SRTF(ArrayList<Task> const &tasks,
+                     ArrayList<uint32_t> const &order) {
+    struct Slot {
+        long long remaining;
+        uint32_t job;
+    };
+    PreemptiveRun run(tasks, order);
+    auto shorter = [&run](Slot const &a, Slot const &b) {
+        if (a.remaining != b.remaining) {
+            return a.remaining < b.remaining;
+        }
+        return arrives_before(run.task(a.job), run.task(b.job));
+    };
+    Heap<Slot, decltype(shorter)> ready(shorter);
+    auto admit = [&] {
+        uint32_t job;
+        while (run.arrive(job)) {
+            ready.push(Slot{run.left(job), job});
+        }
+    };
+    while (!run.done()) {
+        if (ready.empty()) {
+            run.idle();
+        }
+        admit();
+        Slot current = ready.top();
+        ready.pop();
+        // 执行到下一个任务到达，新任务更短时抢占
+        bool preempted = false;
+        while (run.has_arrival() &&
+               run.next_arrival() < run.time() + current.remaining) {
+            long long slice = run.next_arrival() - run.time();
+            run.run(current.job, slice);
+            current.remaining -= slice;
+            admit();
+            if (shorter(ready.top(), current)) {
+                ready.push(current);
+                preempted = true;
+                break;
+            }
+        }
+        if (!preempted) {
+            run.run(current.job, current.remaining);
+        }
+    }
+    return run.result();
+}
+
+inline Schedule SRTF(ArrayList<Task> const &tasks) {
+    return SRTF(tasks, arrival_order(tasks));
+}
+
+/**
+ * 时间片轮转(RR)调度算法
+ * 算法原理：
+ * 1. 就绪任务排成循环队列，队首任务执行至多一个时间片
+ * 2. 时间片用完仍未结束的任务排到队尾；
+ *    执行期间到达的任务排在它前面
+ * 每个时间片 O(1)，总计 O(n + 总执行时间/时间片)
+ * @param tasks 任务列表
+ * @param order 到达顺序，见 arrival_order
+ * @param quantum 时间片长度
+ * @return 调度结果
+ * @throws std::invalid_argument 时间片不是正数
+ */
+inline Schedule RR(ArrayList<Task> const &tasks,
+                   ArrayList<uint32_t> const &order, int quantum) {
+    if (quantum <= 0) {
+        throw std::invalid_argument("quantum must be positive");
+    }
+    PreemptiveRun run(tasks, order);
+    CircularQueue<uint32_t> ready;
+    auto admit = [&] {
+        uint32_t job;
+        while (run.arrive(job)) {
+            ready.enqueue(job);
+        }
+    };
+    while (!run.done()) {
+        if (ready.empty()) {
+            run.idle();
+        }
+        admit();
+        uint32_t job = ready.front();
+        ready.dequeue();
+        run.run(job, std::min<long long>(quantum, run.left(job)));
+        admit();
+        if (run.left(job) > 0) {
+            ready.enqueue(job);
+        }
+    }
+    return run.result();
+}
+
+inline Schedule RR(ArrayList<Task> const &tasks, int quantum) {
+    return RR(tasks, arrival_order(tasks), quantum);
+}
+
+/**
+ * 多级反馈队列(MLFQ)调度算法
+ * 算法原理：
+ * 1. 共 levels 级队列，第 k 级的时间片为 quantum * 2^k，
+ *    新到达的任务进入第 0 级(最高优先级)
+ * 2. 总是执行最高非空级别的队首任务；用完整个时间片的任务降一级，
+ *    最低一级内为时间片轮转
+ * 3. 执行低级别任务时有新任务到达则立即抢占，被抢占的任务留在原级别
+ * 4. boost 为正时每隔 boost 时间把所有任务提回第 0 级，防止长作业饥饿
+ * @param tasks 任务列表
+ * @param order 到达顺序，见 arrival_order
+ * @param quantum 第 0 级的时间片长度
+ * @param levels 队列级数
+ * @param boost 优先级提升周期，0 表示不提升
+ * @return 调度结果
+ * @throws std::invalid_argument 参数不合法
+ */
+inline Schedule MLFQ(ArrayList<Task> const &tasks,
+                     ArrayList<uint32_t> const &order, int quantum,
+                     size_t levels = 3, long long boost = 0) {
+    if (quantum <= 0 || levels == 0 || levels > 32 || boost < 0) {
+        throw std::invalid_argument("invalid MLFQ parameters");
+    }
+    PreemptiveRun run(tasks, order);
+    ArrayList<CircularQueue<uint32_t>> queues(levels,
+                                              CircularQueue<uint32_t>());
+    auto admit = [&] {
+        uint32_t job;
+        while (run.arrive(job)) {
+            queues[0].enqueue(job);
+        }
+    };
+    long long next_boost = boost;
+    while (!run.done()) {
+        size_t level = 0;
+        while (level < levels && queues[level].empty()) {
+            level++;
+        }
+        if (level == levels) {
+            run.idle();
+            admit();
+            continue;
+        }
+        uint32_t job = queues[level].front();
+        queues[level].dequeue();
+        long long slice = static_cast<long long>(quantum) << level;
+        bool full = run.left(job) >= slice;
+        slice = std::min(slice, run.left(job));
+        // 第 0 级以下的任务会被新到达的任务抢占
+        if (level > 0 && run.has_arrival() &&
+            run.next_arrival() - run.time() < slice) {
+            slice = run.next_arrival() - run.time();
+            full = false;
+        }
+        run.run(job, slice);
+        admit();
+        if (run.left(job) > 0) {
+            size_t next_level = full ? std::min(level + 1, levels - 1) : level;
+            queues[next_level].enqueue(job);
+        }
+        if (boost > 0 && run.time() >= next_boost) {
+            for (size_t k = 1; k < levels; k++) {
+                while (!queues[k].empty()) {
+                    queues[0].enqueue(queues[k].front());
+                    queues[k].dequeue();
+                }
+            }
+            next_boost = run.time() - run.time() % boost + boost;
+        }
+    }
+    return run.result();
+}
+
+inline Schedule MLFQ(ArrayList<Task> const &tasks, int quantum,
+                     size_t levels = 3, long long boost = 0) {
+    return MLFQ(tasks, arrival_order(tasks), quantum, levels, boost);
+}
+
+/**
+ * 多核调度结果的汇总统计
+ */
+struct MultiCoreStats {
+    size_t cores;       // 核数
+    double utilization; // 各核忙碌时间之和 / (核数 * 从首个任务到达到全部完成)
+    long long makespan; // 最后一个任务的结束时间
+    long long p50_wait; // 等待时间的中位数
+    long long p99_wait; // 等待时间的 99 百分位数
+    size_t migrations;  // 被其他核窃取执行的任务数
+};
+
+/**
+ * 最近秩法求百分位数，会打乱 values 的顺序
+ * 秩为 ceil(permille * n / 1000)，用整数计算，没有浮点舍入误差
+ * @param values 非空的数据
+ * @param permille 百分位的千分数，取值 (0, 1000]，如 990 表示 99 百分位
+ * @return 不小于 permille / 1000 比例数据的最小值
+ * @throws std::invalid_argument values 为空或 permille 超出范围
+ */
+inline long long percentile(ArrayList<long long> &values, size_t permille) {
+    if (values.empty() || permille == 0 || permille > 1000) {
+        throw std::invalid_argument("invalid percentile");
+    }
+    size_t rank = (permille * values.size() + 999) / 1000;
+    std::nth_element(values.begin(), values.begin() + rank - 1, values.end());
+    return values[rank - 1];
+}
+
+/**
+ * 多核调度的离散事件模拟(各核非抢占、先来先服务)
+ * 算法原理：
+ * 1. 每个核有自己的就绪队列，任务按到达顺序轮流放入各核的队列
+ * 2. 事件为任务到达和某个核完成任务，完成事件按时间放在堆中
+ * 3. 空闲的核先取自己队列的队首任务；队列为空且允许窃取时，
+ *    从排队任务最多的核取走一个任务，记一次迁移
+ * 每个事件一次堆操作加一次 O(核数) 的调度，总计 O(n (log n + 核数))
+ * @param tasks 任务列表
+ * @param order 到达顺序，见 arrival_order
+ * @param cores 核数
+ * @param steal 是否允许空闲核窃取其他核的任务
+ * @return 调度结果，包括各任务所在的核和迁移次数
+ * @throws std::invalid_argument 核数为0或超过 UINT16_MAX，
+ *         或到达顺序与任务列表不对应
+ */
+inline Schedule simulate_cores(ArrayList<Task> const &tasks,
+                               ArrayList<uint32_t> const &order,
+                               size_t cores, bool steal = true) {
+    if (cores == 0 || cores > UINT16_MAX) {
+        throw std::invalid_argument("invalid core count");
+    }
+    check_arrival_order(tasks, order);
+    size_t n = tasks.size();
+    Schedule schedule(n);
+    schedule.core = ArrayList<uint16_t>(n, 0);
+
+    struct Completion {
+        long long time;
+        size_t core;
+        uint32_t index;
+    };
+    auto earlier = [](Completion const &a, Completion const &b) {
+        if (a.time != b.time) {
+            return a.time < b.time;
+        }
+        return a.core < b.core;
+    };
+    Heap<Completion, decltype(earlier)> running(earlier);
+    ArrayList<CircularQueue<uint32_t>> queues(cores,
+                                              CircularQueue<uint32_t>());
+    ArrayStack<size_t> idle(cores);
+    ArrayStack<size_t> still_idle(cores);
+    for (size_t c = cores; c-- > 0;) {
+        idle.push(c);
+    }
+
+    long long now = 0;
+    size_t next = 0;
+    size_t queued = 0;
+    while (next < n || queued > 0 || !running.empty()) {
+        // 跳到下一个事件：任务到达或某个核完成
+        long long event = LLONG_MAX;
+        if (next < n) {
+            event = tasks[order[next]].submit_time;
+        }
+        if (!running.empty()) {
+            event = std::min(event, running.top().time);
+        }
+        now = std::max(now, event);
+        while (!running.empty() && running.top().time <= now) {
+            schedule.order.push_back(running.top().index);
+            idle.push(running.top().core);
+            running.pop();
+        }
+        while (next < n && tasks[order[next]].submit_time <= now) {
+            queues[next % cores].enqueue(order[next]);
+            next++;
+            queued++;
+        }
+
+        // 给每个空闲的核分配任务
+        while (queued > 0 && !idle.empty()) {
+            size_t core = idle.top();
+            idle.pop();
+            size_t source = core;
+            if (queues[core].empty()) {
+                if (steal) {
+                    for (size_t c = 0; c < cores; c++) {
+                        if (queues[c].size() > queues[source].size()) {
+                            source = c;
+                        }
+                    }
+                }
+                if (queues[source].empty()) {
+                    still_idle.push(core);
+                    continue;
+                }
+                schedule.migrations++;
+            }
+            uint32_t job = queues[source].front();
+            queues[source].dequeue();
+            queued--;
+            schedule.core[job] = static_cast<uint16_t>(core);
+            schedule.start[job] = now;
+            schedule.end[job] = now + tasks[job].cpu_time;
+            running.push(Completion{schedule.end[job], core, job});
+        }
+        while (!still_idle.empty()) {
+            idle.push(still_idle.top());
+            still_idle.pop();
+        }
+    }
+    return schedule;
+}
+
+inline Schedule simulate_cores(ArrayList<Task> const &tasks, size_t cores,
+                               bool steal = true) {
+    return simulate_cores(tasks, arrival_order(tasks), cores, steal);
+}
+
+/**
+ * 汇总一次多核调度的结果
+ * @param tasks 任务列表
+ * @param schedule simulate_cores 得到的调度结果
+ * @param cores 模拟时的核数
+ * @return 多核汇总统计
+ */
+inline MultiCoreStats summarize_cores(ArrayList<Task> const &tasks,
+                                      Schedule const &schedule,
+                                      size_t cores) {
+    MultiCoreStats stats = {cores, 0, 0, 0, 0, schedule.migrations};
+    size_t n = tasks.size();
+    if (n == 0) {
+        return stats;
+    }
+    ArrayList<long long> waits(n);
+    long long busy = 0;
+    long long first = LLONG_MAX;
+    for (size_t i = 0; i < n; i++) {
+        waits.push_back(schedule.wait(tasks, i));
+        busy += tasks[i].cpu_time;
+        first = std::min<long long>(first, tasks[i].submit_time);
+        stats.makespan = std::max(stats.makespan, schedule.end[i]);
+    }
+    long long span = stats.makespan - first;
+    if (span > 0) {
+        stats.utilization = static_cast<double>(busy) / (span * cores);
+    }
+    stats.p50_wait = percentile(waits, 500);
+    stats.p99_wait = percentile(waits, 990);
+    return stats;
+}
+
+#endif // !SCHEDULER_H
@@ -0,0 +1,176 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "../MyDS/arraylist.h"
+#include "scheduler.h"
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+/**
+ * 从输入流读入任务轨迹
+ * 格式为空白分隔的 "ID CPU时间 提交时间" 三元组，直到输入结束。
+ * 以 64 KiB 为块读入，用 from_chars 直接在缓冲区上解析，
+ * 块末尾不完整的数字留到下一块开头
+ * @param in 输入流
+ * @return 按输入顺序排列的任务列表
+ * @throws std::runtime_error 读取失败、含有非整数内容或三元组不完整
+ */
+inline ArrayList<Task> load_trace(std::istream &in) {
+    constexpr size_t BUFFER_SIZE = 64 << 10;
+    auto is_space = [](char c) {
+        return c == ' ' || c == '\n' || c == '\t' || c == '\r' ||
+               c == '\v' || c == '\f';
+    };
+    std::string buffer(BUFFER_SIZE, '\0');
+    ArrayList<Task> tasks;
+    int fields[3];
+    size_t field = 0;
+    size_t kept = 0;     // 上一块留下的不完整数字的长度
+    size_t consumed = 0; // 缓冲区开头在输入中的偏移，用于报错
+    bool eof = false;
+    while (!eof) {
+        char *data = &buffer[0];
+        in.read(data + kept, BUFFER_SIZE - kept);
+        size_t got = static_cast<size_t>(in.gcount());
+        eof = kept + got < BUFFER_SIZE;
+        if (in.bad()) {
+            throw std::runtime_error("failed to read trace");
+        }
+        char const *p = data;
+        char const *end = data + kept + got;
+        char const *limit = end;
+        if (!eof) {
+            while (limit > p && !is_space(limit[-1])) {
+                limit--;
+            }
+            if (limit == p) {
+                throw std::runtime_error("malformed trace near byte " +
+                                         std::to_string(consumed));
+            }
+        }
+        while (true) {
+            while (p < limit && is_space(*p)) {
+                p++;
+            }
+            if (p == limit) {
+                break;
+            }
+            int value;
+            auto [ptr, ec] = std::from_chars(p, limit, value);
+            if (ec != std::errc() || (ptr < limit && !is_space(*ptr))) {
+                throw std::runtime_error(
+                    "malformed trace near byte " +
+                    std::to_string(consumed + (p - data)));
+            }
+            fields[field++] = value;
+            if (field == 3) {
+                tasks.push_back(Task(fields[0], fields[1], fields[2]));
+                field = 0;
+            }
+            p = ptr;
+        }
+        kept = end - limit;
+        std::memmove(data, limit, kept);
+        consumed += limit - data;
+    }
+    if (field != 0) {
+        throw std::runtime_error("truncated trace");
+    }
+    return tasks;
+}
+
+/**
+ * 一种调度策略在一条轨迹上的模拟结果
+ */
+struct PolicyResult {
+    std::string name;  // 策略名称
+    Schedule schedule; // 调度结果
+    double seconds;    // 模拟耗时(秒)
+    size_t cores;      // 多核模拟的核数，单核策略为0
+};
+
+/**
+ * 在同一份只读任务列表上并发运行全部调度策略，每种策略一个线程
+ * 到达顺序在启动线程前求一次，各线程只读 tasks 和它，
+ * 结果写入各自的 PolicyResult，互不共享可写数据
+ * @param tasks 任务列表
+ * @param quantum RR 和 MLFQ 的时间片
+ * @param cores 多核模拟的核数
+ * @return 各策略的结果，顺序固定为 FCFS、SJF、SRTF、RR、MLFQ、
+ *         多核(窃取)、多核(不窃取)
+ * @throws 任一策略抛出的异常，在所有线程结束后重新抛出；
+ *         创建线程失败时，已启动的线程结束后抛出 std::system_error
+ */
+inline ArrayList<PolicyResult> run_policies(ArrayList<Task> const &tasks,
+                                            int quantum, size_t cores) {
+    ArrayList<uint32_t> const order = arrival_order(tasks);
+    struct Policy {
+        std::string name;
+        size_t cores;
+        std::function<Schedule()> run;
+    };
+    std::string q = std::to_string(quantum);
+    std::string k = std::to_string(cores);
+    Policy policies[] = {
+        {"FCFS", 0, [&] { return FCFS(tasks, order); }},
+        {"SJF", 0, [&] { return SJF(tasks, order); }},
+        {"SRTF", 0, [&] { return SRTF(tasks, order); }},
+        {"RR(q=" + q + ")", 0, [&] { return RR(tasks, order, quantum); }},
+        {"MLFQ(q=" + q + ")", 0,
+         [&] { return MLFQ(tasks, order, quantum); }},
+        {k + " cores, stealing", cores,
+         [&] { return simulate_cores(tasks, order, cores, true); }},
+        {k + " cores, no stealing", cores,
+         [&] { return simulate_cores(tasks, order, cores, false); }},
+    };
+    constexpr size_t COUNT = sizeof(policies) / sizeof(policies[0]);
+
+    ArrayList<PolicyResult> results(COUNT, PolicyResult());
+    ArrayList<std::exception_ptr> errors(COUNT, nullptr);
+    // 析构时等待所有已启动的线程，创建某个线程失败时也不会遗留线程
+    struct Workers {
+        std::thread threads[COUNT];
+
+        ~Workers() {
+            for (std::thread &thread: threads) {
+                if (thread.joinable()) {
+                    thread.join();
+                }
+            }
+        }
+    } workers;
+    for (size_t i = 0; i < COUNT; i++) {
+        results[i].name = policies[i].name;
+        results[i].cores = policies[i].cores;
+        workers.threads[i] = std::thread([&, i] {
+            try {
+                auto start = std::chrono::steady_clock::now();
+                results[i].schedule = policies[i].run();
+                results[i].seconds = std::chrono::duration<double>(
+                                         std::chrono::steady_clock::now() -
+                                         start)
+                                         .count();
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
+    }
+    for (std::thread &thread: workers.threads) {
+        thread.join();
+    }
+    for (auto const &error: errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return results;
+}
+
+#endif // !TRACE_H
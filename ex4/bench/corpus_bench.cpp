@@ -0,0 +1,312 @@
+// 压缩基准测试：生成（或读入）语料，对 HuffmanTree 的各种模式分别测量
+// 建树时间、压缩/解压速度、压缩率和峰值内存，并校验解压结果与原文一致。
+// 用法：huff_bench [-s 大小(MiB)] [-d 工作目录] [文件...]
+// 不给文件时使用生成的语料：文本、偏斜二进制、随机、单一字节、斐波那契
+// 频率（码长最长的情形）和空文件。每个模式在子进程中运行，峰值内存互不影响
+
+#include "../huffblock.h"
+#include "../huffstream.h"
+#include "../hufftree.h"
+#include "../mappedfile.h"
+#include "../threadpool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+using namespace std;
+
+namespace {
+
+struct Result {
+    double build_seconds;
+    double compress_seconds;
+    double decompress_seconds;
+    uint64_t compressed_size;
+    long peak_rss_kib;
+    bool round_trip;
+};
+
+double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start)
+        .count();
+}
+
+void write_file(string const &path, string const &data) {
+    ofstream out(path, ios::binary);
+    out.write(data.data(), data.size());
+}
+
+// 类似日志的文本：单词按 Zipf 分布取自固定词表
+string make_text(size_t bytes, mt19937 &rng) {
+    static char const *words[] = {
+        "the",     "request", "server", "error",   "user",    "id",
+        "time",    "ms",      "GET",    "POST",    "/api/v1", "status",
+        "200",     "404",     "500",    "session", "cache",   "miss",
+        "hit",     "latency", "worker", "queue",   "done",    "retry",
+        "timeout", "connect", "close",  "bytes",   "INFO",    "WARN",
+    };
+    constexpr size_t WORDS = sizeof(words) / sizeof(words[0]);
+    double weights[WORDS];
+    for (size_t i = 0; i < WORDS; i++) {
+        weights[i] = 1.0 / (i + 1);
+    }
+    discrete_distribution<size_t> pick(weights, weights + WORDS);
+    uniform_int_distribution<int> number(0, 99999);
+    string text;
+    text.reserve(bytes + 64);
+    while (text.size() < bytes) {
+        text += to_string(number(rng));
+        for (int i = 0; i < 8; i++) {
+            text += ' ';
+            text += words[pick(rng)];
+        }
+        text += '\n';
+    }
+    text.resize(bytes);
+    return text;
+}
+
+string make_skewed(size_t bytes, mt19937 &rng) {
+    geometric_distribution<int> dist(0.05);
+    string data(bytes, '\0');
+    for (char &ch: data) {
+        ch = static_cast<char>(min(dist(rng), 255));
+    }
+    return data;
+}
+
+string make_random(size_t bytes, mt19937 &rng) {
+    uniform_int_distribution<int> dist(0, 255);
+    string data(bytes, '\0');
+    for (char &ch: data) {
+        ch = static_cast<char>(dist(rng));
+    }
+    return data;
+}
+
+// 频率依次为斐波那契数，不限码长时哈夫曼树退化成一条链
+string make_fibonacci(size_t bytes, mt19937 &rng) {
+    string data;
+    size_t a = 1;
+    size_t b = 1;
+    for (int ch = 0; ch < 256 && data.size() + a <= bytes; ch++) {
+        data.append(a, static_cast<char>(ch));
+        size_t next = a + b;
+        a = b;
+        b = next;
+    }
+    shuffle(data.begin(), data.end(), rng);
+    return data;
+}
+
+bool same_file(string const &a, string const &b) {
+    MappedFile x(a);
+    MappedFile y(b);
+    return x.size() == y.size() &&
+           (x.size() == 0 || memcmp(x.data(), y.data(), x.size()) == 0);
+}
+
+uint64_t file_size(string const &path) {
+    return MappedFile(path).size();
+}
+
+// 各模式：压缩 input 到 packed，再解压到 restored
+Result run_mode(string const &mode, string const &input, string const &packed,
+                string const &restored) {
+    Result result = {};
+    auto start = chrono::steady_clock::now();
+    if (mode == "classic" || mode == "limit12" || mode == "mmap") {
+        HuffmanTree tree;
+        if (mode == "mmap") {
+            tree.build_tree_mapped(input);
+        } else {
+            tree.build_tree(input, mode == "limit12" ? 12 : 0);
+        }
+        result.build_seconds = seconds_since(start);
+        start = chrono::steady_clock::now();
+        if (mode == "mmap") {
+            tree.compress_mapped(input, packed);
+        } else {
+            tree.compress(input, packed);
+        }
+        result.compress_seconds = seconds_since(start);
+        start = chrono::steady_clock::now();
+        if (mode == "mmap") {
+            tree.decompress_mapped(packed, restored);
+        } else {
+            tree.decompress(packed, restored);
+        }
+        result.decompress_seconds = seconds_since(start);
+    } else if (mode == "block") {
+        ThreadPool pool;
+        BlockCompressor(pool).compress(input, packed);
+        result.compress_seconds = seconds_since(start);
+        start = chrono::steady_clock::now();
+        BlockReader(packed).decompress(pool, restored);
+        result.decompress_seconds = seconds_since(start);
+    } else if (mode == "stream" || mode == "adaptive") {
+        huffstream::Options options;
+        options.adaptive = mode == "adaptive";
+        {
+            ifstream in(input, ios::binary);
+            ofstream out(packed, ios::binary);
+            huffstream::compress(in, out, options);
+        }
+        result.compress_seconds = seconds_since(start);
+        start = chrono::steady_clock::now();
+        {
+            ifstream in(packed, ios::binary);
+            ofstream out(restored, ios::binary);
+            huffstream::decompress(in, out);
+        }
+        result.decompress_seconds = seconds_since(start);
+    } else {
+        throw invalid_argument("unknown mode " + mode);
+    }
+    result.compressed_size = file_size(packed);
+    result.round_trip = same_file(input, restored);
+    return result;
+}
+
+// 在子进程中运行一个模式，通过管道取回结果；失败时 round_trip 为假
+Result run_isolated(string const &mode, string const &input,
+                    string const &work) {
+    string packed = work + "/bench.packed";
+    string restored = work + "/bench.restored";
+    int fds[2];
+    if (pipe(fds) != 0) {
+        throw runtime_error("pipe failed");
+    }
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        Result result = {};
+        try {
+            result = run_mode(mode, input, packed, restored);
+        } catch (exception const &e) {
+            cerr << mode << ": " << e.what() << '\n';
+            result.round_trip = false;
+        }
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        result.peak_rss_kib = usage.ru_maxrss;
+        ssize_t written = write(fds[1], &result, sizeof(result));
+        _exit(written == sizeof(result) ? 0 : 1);
+    }
+    close(fds[1]);
+    Result result = {};
+    if (read(fds[0], &result, sizeof(result)) != sizeof(result)) {
+        result = Result{};
+    }
+    close(fds[0]);
+    waitpid(pid, nullptr, 0);
+    remove(packed.c_str());
+    remove(restored.c_str());
+    return result;
+}
+
+string rate(uint64_t bytes, double seconds) {
+    if (seconds <= 0 || bytes == 0) {
+        return "-";
+    }
+    ostringstream os;
+    os << fixed << setprecision(1) << bytes / seconds / (1 << 20);
+    return os.str();
+}
+
+// 分块和流式模式的建树包含在压缩过程中，不单独计时
+string milliseconds(double seconds) {
+    if (seconds <= 0) {
+        return "-";
+    }
+    ostringstream os;
+    os << fixed << setprecision(1) << seconds * 1000;
+    return os.str();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    size_t mib = 32;
+    string work = ".";
+    ArrayList<Pair<string, string>> corpus;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            mib = stoul(argv[++i]);
+        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            work = argv[++i];
+        } else {
+            corpus.push_back(Pair(string(argv[i]), string(argv[i])));
+        }
+    }
+
+    ArrayList<string> generated;
+    if (corpus.empty()) {
+        size_t bytes = mib << 20;
+        mt19937 rng(2024);
+        struct {
+            char const *name;
+            string (*make)(size_t, mt19937 &);
+        } makers[] = {
+            {"text", make_text},     {"skewed", make_skewed},
+            {"random", make_random}, {"fibonacci", make_fibonacci},
+        };
+        for (auto const &maker: makers) {
+            string path = work + "/corpus." + maker.name;
+            write_file(path, maker.make(bytes, rng));
+            corpus.push_back(Pair(string(maker.name), path));
+        }
+        string single = work + "/corpus.single";
+        write_file(single, string(bytes, 'a'));
+        corpus.push_back(Pair(string("single"), single));
+        string empty = work + "/corpus.empty";
+        write_file(empty, "");
+        corpus.push_back(Pair(string("empty"), empty));
+        for (auto const &item: corpus) {
+            generated.push_back(item.second);
+        }
+    }
+
+    char const *modes[] = {"classic", "limit12",  "mmap",
+                           "block",   "stream", "adaptive"};
+    cout << left << setw(12) << "corpus" << setw(10) << "mode" << right
+         << setw(12) << "bytes" << setw(10) << "build ms" << setw(12)
+         << "comp MiB/s" << setw(12) << "dec MiB/s" << setw(8) << "ratio"
+         << setw(10) << "RSS MiB" << "  check\n";
+
+    bool all_ok = true;
+    for (auto const &item: corpus) {
+        uint64_t size = file_size(item.second);
+        for (char const *mode: modes) {
+            Result r = run_isolated(mode, item.second, work);
+            all_ok = all_ok && r.round_trip;
+            double ratio = size == 0 ? 0.0 : double(r.compressed_size) / size;
+            cout << left << setw(12) << item.first << setw(10) << mode
+                 << right << setw(12) << size << setw(10)
+                 << milliseconds(r.build_seconds) << setw(12)
+                 << rate(size, r.compress_seconds) << setw(12)
+                 << rate(size, r.decompress_seconds) << setw(8)
+                 << fixed << setprecision(3) << ratio
+                 << setw(10) << setprecision(1) << r.peak_rss_kib / 1024.0
+                 << "  " << (r.round_trip ? "ok" : "FAIL") << '\n';
+        }
+    }
+
+    for (auto const &path: generated) {
+        remove(path.c_str());
+    }
+    if (!all_ok) {
+        cerr << "round trip failed\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,181 @@
+// 输入路径基准测试：比较逐字节 ifstream、大块缓冲读取和内存映射
+// 三种方式统计字节频率的速度，以及缓冲写出与映射写出的压缩速度。
+// 用法：huff_io_bench [文件路径] [大小(MiB)]，文件不存在时自动生成
+
+#include "../histogram.h"
+#include "../hufftree.h"
+#include "../mappedfile.h"
+#include "../threadpool.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+using namespace std;
+
+namespace {
+
+double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start)
+        .count();
+}
+
+void report(string const &name, size_t bytes, double seconds) {
+    cout << left << setw(28) << name << right << setw(10) << fixed
+         << setprecision(3) << seconds << " s" << setw(12)
+         << setprecision(1) << bytes / seconds / (1 << 20) << " MiB/s\n";
+}
+
+// 生成带偏斜分布的文本，使哈夫曼码长接近真实日志
+void generate(string const &path, size_t bytes) {
+    ofstream out(path, ios::binary);
+    mt19937 rng(42);
+    geometric_distribution<int> dist(0.08);
+    string buf(1 << 20, '\0');
+    for (size_t written = 0; written < bytes; written += buf.size()) {
+        for (char &ch: buf) {
+            ch = static_cast<char>(' ' + dist(rng) % 95);
+        }
+        out.write(buf.data(), min(buf.size(), bytes - written));
+    }
+}
+
+size_t checksum(size_t const *freq) {
+    size_t sum = 0;
+    for (size_t ch = 0; ch < 256; ch++) {
+        sum += freq[ch] * (ch + 1);
+    }
+    return sum;
+}
+
+size_t count_per_byte(string const &path) {
+    size_t freq[256] = {};
+    ifstream in(path, ios::binary);
+    unsigned char ch;
+    while (in.read(reinterpret_cast<char *>(&ch), sizeof(ch))) {
+        freq[ch]++;
+    }
+    return checksum(freq);
+}
+
+size_t count_buffered(string const &path) {
+    size_t freq[256] = {};
+    ifstream in(path, ios::binary);
+    string buf(1 << 20, '\0');
+    while (in) {
+        in.read(&buf[0], buf.size());
+        histogram(reinterpret_cast<unsigned char const *>(buf.data()),
+                  in.gcount(), freq);
+    }
+    return checksum(freq);
+}
+
+size_t count_mapped(string const &path) {
+    size_t freq[256] = {};
+    MappedFile in(path);
+    histogram(in.data(), in.size(), freq);
+    return checksum(freq);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    string path = argc > 1 ? argv[1] : "io_bench.dat";
+    size_t mib = argc > 2 ? stoul(argv[2]) : 1024;
+    size_t bytes = mib << 20;
+
+    if (!ifstream(path).good()) {
+        cout << "generating " << path << " (" << mib << " MiB)\n";
+        generate(path, bytes);
+    }
+    bytes = MappedFile(path).size();
+    // 先完整读一遍，让三种方式都从页缓存读取
+    count_buffered(path);
+
+    cout << "frequency count:\n";
+    size_t expected = 0;
+    struct {
+        char const *name;
+        size_t (*run)(string const &);
+    } counters[] = {
+        {"ifstream per byte", count_per_byte},
+        {"ifstream 1 MiB buffered", count_buffered},
+        {"mmap + MADV_SEQUENTIAL", count_mapped},
+    };
+    for (auto const &counter: counters) {
+        auto start = chrono::steady_clock::now();
+        size_t sum = counter.run(path);
+        report(counter.name, bytes, seconds_since(start));
+        if (expected != 0 && sum != expected) {
+            cerr << "checksum mismatch in " << counter.name << '\n';
+            return 1;
+        }
+        expected = sum;
+    }
+
+    // 数据已在内存中时单独比较计数内核
+    cout << "histogram kernel (mapped, in page cache):\n";
+    {
+        MappedFile in(path);
+        unsigned char const *data = in.data();
+        // 预先触发所有缺页，计时只包含计数本身
+        size_t warm[256] = {};
+        histogram(data, in.size(), warm);
+        size_t naive[256] = {};
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < in.size(); i++) {
+            naive[data[i]]++;
+        }
+        report("single counter array", bytes, seconds_since(start));
+
+        size_t banked[256] = {};
+        start = chrono::steady_clock::now();
+        histogram(data, in.size(), banked);
+        report("4 banks, 16 bytes/iter", bytes, seconds_since(start));
+
+        ThreadPool pool;
+        size_t parallel[256] = {};
+        start = chrono::steady_clock::now();
+        histogram(data, in.size(), parallel, &pool);
+        report("4 banks, " + to_string(pool.size()) + " threads", bytes,
+               seconds_since(start));
+        if (checksum(naive) != expected || checksum(banked) != expected ||
+            checksum(parallel) != expected) {
+            cerr << "histogram mismatch\n";
+            return 1;
+        }
+    }
+
+    cout << "compress:\n";
+    HuffmanTree tree;
+    tree.build_tree_mapped(path);
+    string output = path + ".huff";
+
+    auto start = chrono::steady_clock::now();
+    tree.compress(path, output);
+    report("buffered read + ofstream", bytes, seconds_since(start));
+
+    start = chrono::steady_clock::now();
+    tree.compress_mapped(path, output);
+    report("mmap read + mmap write", bytes, seconds_since(start));
+
+    start = chrono::steady_clock::now();
+    tree.decompress_mapped(output, path + ".out");
+    report("mmap decompress", bytes, seconds_since(start));
+
+    MappedFile original(path);
+    MappedFile restored(path + ".out");
+    bool same = original.size() == restored.size() &&
+                (original.size() == 0 ||
+                 memcmp(original.data(), restored.data(), original.size()) ==
+                     0);
+    remove(output.c_str());
+    remove((path + ".out").c_str());
+    if (!same) {
+        cerr << "round trip mismatch\n";
+        return 1;
+    }
+    return 0;
+}
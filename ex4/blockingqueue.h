@@ -0,0 +1,59 @@
+#ifndef BLOCKING_QUEUE_H
+#define BLOCKING_QUEUE_H
+
+#include "../MyDS/circularqueue.h"
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+// 有界阻塞队列：队满时 push 等待，队空时 pop 等待；
+// close 之后 push 返回 false，pop 取完剩余元素后返回 false
+template <typename T>
+class BlockingQueue {
+public:
+    explicit BlockingQueue(size_t capacity)
+        : queue(capacity),
+          capacity(capacity),
+          closed(false) {}
+
+    bool push(T const &value) {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_full.wait(lock,
+                      [this] { return closed || queue.size() < capacity; });
+        if (closed) {
+            return false;
+        }
+        queue.enqueue(value);
+        not_empty.notify_one();
+        return true;
+    }
+
+    bool pop(T &value) {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_empty.wait(lock, [this] { return closed || !queue.empty(); });
+        if (queue.empty()) {
+            return false;
+        }
+        value = queue.front();
+        queue.dequeue();
+        not_full.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        not_full.notify_all();
+        not_empty.notify_all();
+    }
+
+private:
+    CircularQueue<T> queue;
+    size_t capacity;
+    bool closed;
+    std::mutex mutex;
+    std::condition_variable not_full;
+    std::condition_variable not_empty;
+};
+
+#endif // !BLOCKING_QUEUE_H
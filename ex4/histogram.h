@@ -0,0 +1,80 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include "../MyDS/arraylist.h"
+#include "threadpool.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// 字节直方图：结果累加到 256 项的 freq 中。
+// 连续相同的字节会反复读写同一个计数器，形成存储到读取的依赖链；
+// 这里用 4 组交错的 uint32_t[256] 计数器轮流计数，每轮读入 16 字节，
+// 最后再把各组合并。每段最多 1 GiB，保证 32 位计数器不会溢出
+inline void histogram(unsigned char const *data, size_t size, size_t *freq) {
+    constexpr size_t SEGMENT = size_t(1) << 30;
+    uint32_t counts[4][256];
+    while (size > 0) {
+        size_t n = std::min(size, SEGMENT);
+        std::memset(counts, 0, sizeof(counts));
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            uint64_t a;
+            uint64_t b;
+            std::memcpy(&a, data + i, 8);
+            std::memcpy(&b, data + i + 8, 8);
+            counts[0][a & 0xff]++;
+            counts[1][(a >> 8) & 0xff]++;
+            counts[2][(a >> 16) & 0xff]++;
+            counts[3][(a >> 24) & 0xff]++;
+            counts[0][(a >> 32) & 0xff]++;
+            counts[1][(a >> 40) & 0xff]++;
+            counts[2][(a >> 48) & 0xff]++;
+            counts[3][a >> 56]++;
+            counts[0][b & 0xff]++;
+            counts[1][(b >> 8) & 0xff]++;
+            counts[2][(b >> 16) & 0xff]++;
+            counts[3][(b >> 24) & 0xff]++;
+            counts[0][(b >> 32) & 0xff]++;
+            counts[1][(b >> 40) & 0xff]++;
+            counts[2][(b >> 48) & 0xff]++;
+            counts[3][b >> 56]++;
+        }
+        for (; i < n; i++) {
+            counts[0][data[i]]++;
+        }
+        for (size_t ch = 0; ch < 256; ch++) {
+            freq[ch] += size_t(counts[0][ch]) + counts[1][ch] +
+                        counts[2][ch] + counts[3][ch];
+        }
+        data += n;
+        size -= n;
+    }
+}
+
+// 多线程版本：按线程数切分输入，各线程独立计数后归并。
+// 输入较小或没有线程池时退回单线程版本
+inline void histogram(unsigned char const *data, size_t size, size_t *freq,
+                      ThreadPool *pool) {
+    constexpr size_t MIN_SLICE = 4 << 20;
+    if (pool == nullptr || pool->size() == 1 || size < 2 * MIN_SLICE) {
+        histogram(data, size, freq);
+        return;
+    }
+    size_t slices = std::min(pool->size(), size / MIN_SLICE);
+    size_t slice = (size + slices - 1) / slices;
+    ArrayList<size_t> partial(slices * 256, 0);
+    pool->run(slices, [&](size_t i) {
+        size_t begin = i * slice;
+        size_t end = std::min(size, begin + slice);
+        histogram(data + begin, end - begin, partial.begin() + i * 256);
+    });
+    for (size_t i = 0; i < slices; i++) {
+        for (size_t ch = 0; ch < 256; ch++) {
+            freq[ch] += partial[i * 256 + ch];
+        }
+    }
+}
+
+#endif // !HISTOGRAM_H
@@ -0,0 +1,301 @@
+#ifndef HUFF_BLOCK_H
+#define HUFF_BLOCK_H
+
+#include "../MyDS/arraylist.h"
+#include "histogram.h"
+#include "hufftree.h"
+#include "mappedfile.h"
+#include "threadpool.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+// 分块容器格式（多字节整数均为小端序）：
+//   文件头  "HFB1" | u32 块大小 | u64 原文长度 | 256 字节码长表
+//   数据块  各块独立编码、从字节边界开始，共用文件头中的范式码表
+//   块索引  每块 u64 文件内偏移 | u32 压缩后长度
+//   文件尾  u64 索引偏移 | u32 块数 | "HFBI"
+namespace huffblock {
+
+constexpr size_t DEFAULT_BLOCK_SIZE = 256 * 1024;
+constexpr size_t HEADER_SIZE = 4 + 4 + 8 + 256;
+constexpr size_t INDEX_ENTRY_SIZE = 8 + 4;
+constexpr size_t TRAILER_SIZE = 8 + 4 + 4;
+
+inline void put_u32(std::string &out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out += static_cast<char>(value >> (8 * i));
+    }
+}
+
+inline void put_u64(std::string &out, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        out += static_cast<char>(value >> (8 * i));
+    }
+}
+
+inline uint32_t get_u32(char const *p) {
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; i--) {
+        value = (value << 8) | static_cast<unsigned char>(p[i]);
+    }
+    return value;
+}
+
+inline uint64_t get_u64(char const *p) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--) {
+        value = (value << 8) | static_cast<unsigned char>(p[i]);
+    }
+    return value;
+}
+
+} // namespace huffblock
+
+// 分块压缩器：输入映射到内存，先并行统计各块频率并合成一张共享码表，
+// 再并行编码各块。两遍都直接访问映射，输入只从磁盘读一次、不复制；
+// 每批编码 线程数*4 个块，除映射外的内存占用与文件大小无关
+class BlockCompressor {
+public:
+    explicit BlockCompressor(
+        ThreadPool &pool, size_t block_size = huffblock::DEFAULT_BLOCK_SIZE,
+        size_t max_length = 0)
+        : pool(pool),
+          block_size(block_size),
+          max_length(max_length) {
+        if (block_size == 0 || block_size > UINT32_MAX) {
+            throw std::invalid_argument("invalid block size");
+        }
+    }
+
+    void compress(std::string const &input_file,
+                  std::string const &output_file) {
+        using namespace huffblock;
+        MappedFile in(input_file);
+        uint64_t total = in.size();
+        size_t blocks = (in.size() + block_size - 1) / block_size;
+        size_t freq[256] = {};
+        count_blocks(in, blocks, freq);
+
+        HuffmanTree tree;
+        if (total > 0) {
+            tree.build(freq, max_length);
+        }
+        std::string header("HFB1");
+        put_u32(header, static_cast<uint32_t>(block_size));
+        put_u64(header, total);
+        uint8_t lengths[256] = {};
+        if (total > 0) {
+            tree.store_lengths(lengths);
+        }
+        header.append(reinterpret_cast<char const *>(lengths), 256);
+
+        std::ofstream out(output_file, std::ios::binary);
+        out.write(header.data(), header.size());
+
+        std::string index;
+        uint64_t offset = HEADER_SIZE;
+        size_t batch = batch_size();
+        ArrayList<std::string> packed(batch, std::string());
+        for (size_t first = 0; first < blocks; first += batch) {
+            size_t n = std::min(batch, blocks - first);
+            pool.run(n, [&](size_t i) {
+                size_t begin = (first + i) * block_size;
+                size_t length = std::min(block_size, in.size() - begin);
+                packed[i].clear();
+                // 编码结果通常不长于原文，写入缓冲区按块长分配即可
+                BitWriter writer(packed[i], length);
+                tree.encode(in.data() + begin, length, writer);
+                writer.finish();
+            });
+            for (size_t i = 0; i < n; i++) {
+                out.write(packed[i].data(), packed[i].size());
+                put_u64(index, offset);
+                put_u32(index, static_cast<uint32_t>(packed[i].size()));
+                offset += packed[i].size();
+            }
+        }
+
+        std::string trailer;
+        put_u64(trailer, offset);
+        put_u32(trailer, static_cast<uint32_t>(blocks));
+        trailer += "HFBI";
+        out.write(index.data(), index.size());
+        out.write(trailer.data(), trailer.size());
+        if (!out) {
+            throw std::runtime_error("failed to write " + output_file);
+        }
+    }
+
+private:
+    ThreadPool &pool;
+    size_t block_size;
+    size_t max_length;
+
+    size_t batch_size() const {
+        return pool.size() * 4;
+    }
+
+    // 第一遍：按批并行统计各块频率，归并到 freq
+    void count_blocks(MappedFile const &in, size_t blocks, size_t *freq) {
+        size_t batch = batch_size();
+        ArrayList<size_t> counts(batch * 256, 0);
+        for (size_t first = 0; first < blocks; first += batch) {
+            size_t n = std::min(batch, blocks - first);
+            pool.run(n, [&](size_t i) {
+                size_t begin = (first + i) * block_size;
+                size_t *local = counts.begin() + i * 256;
+                std::fill(local, local + 256, 0);
+                histogram(in.data() + begin,
+                          std::min(block_size, in.size() - begin), local);
+            });
+            for (size_t i = 0; i < n * 256; i++) {
+                freq[i % 256] += counts[i];
+            }
+        }
+    }
+};
+
+// 分块读取器：载入码表和块索引后，可随机解压任意一块
+class BlockReader {
+public:
+    explicit BlockReader(std::string const &filename)
+        : in(filename, std::ios::binary),
+          block_size(0),
+          total(0) {
+        using namespace huffblock;
+        if (!in) {
+            throw std::runtime_error("cannot open " + filename);
+        }
+        in.seekg(0, std::ios::end);
+        uint64_t file_size = static_cast<uint64_t>(in.tellg());
+        in.seekg(0);
+        char header[HEADER_SIZE];
+        if (file_size < HEADER_SIZE + TRAILER_SIZE ||
+            !in.read(header, HEADER_SIZE) ||
+            std::memcmp(header, "HFB1", 4) != 0) {
+            throw std::runtime_error("not a block container: " + filename);
+        }
+        block_size = get_u32(header + 4);
+        total = get_u64(header + 8);
+        if (block_size == 0) {
+            throw std::runtime_error("corrupt block container: " + filename);
+        }
+        if (total > 0) {
+            tree.load_lengths(reinterpret_cast<uint8_t *>(header + 16));
+        }
+
+        char trailer[TRAILER_SIZE];
+        in.seekg(-static_cast<std::streamoff>(TRAILER_SIZE), std::ios::end);
+        if (!in.read(trailer, TRAILER_SIZE) ||
+            std::memcmp(trailer + 12, "HFBI", 4) != 0) {
+            throw std::runtime_error("missing block index: " + filename);
+        }
+        // 索引必须恰好填满数据块与文件尾之间的空间，块数必须与原文长度相符，
+        // 检查通过后才按块数分配索引
+        uint64_t index_offset = get_u64(trailer);
+        size_t blocks = get_u32(trailer + 8);
+        uint64_t index_end = file_size - TRAILER_SIZE;
+        uint64_t expected = total / block_size + (total % block_size != 0);
+        if (index_offset < HEADER_SIZE || index_offset > index_end ||
+            index_end - index_offset !=
+                static_cast<uint64_t>(blocks) * INDEX_ENTRY_SIZE ||
+            blocks != expected) {
+            throw std::runtime_error("corrupt block index: " + filename);
+        }
+        std::string index(blocks * INDEX_ENTRY_SIZE, '\0');
+        in.seekg(static_cast<std::streamoff>(index_offset));
+        if (!in.read(&index[0], index.size())) {
+            throw std::runtime_error("truncated block index: " + filename);
+        }
+        for (size_t i = 0; i < blocks; i++) {
+            char const *entry = index.data() + i * INDEX_ENTRY_SIZE;
+            uint64_t offset = get_u64(entry);
+            uint32_t size = get_u32(entry + 8);
+            // 每块都必须落在文件头与索引之间
+            if (offset < HEADER_SIZE || offset > index_offset ||
+                size > index_offset - offset) {
+                throw std::runtime_error("corrupt block index: " + filename);
+            }
+            offsets.push_back(offset);
+            sizes.push_back(size);
+        }
+    }
+
+    size_t block_count() const {
+        return offsets.size();
+    }
+
+    uint64_t original_size() const {
+        return total;
+    }
+
+    // 第 i 块解压后的长度
+    size_t block_length(size_t i) const {
+        uint64_t begin = static_cast<uint64_t>(i) * block_size;
+        return static_cast<size_t>(std::min<uint64_t>(block_size,
+                                                      total - begin));
+    }
+
+    // 读出第 i 块的压缩数据
+    void load(size_t i, std::string &packed) {
+        packed.resize(sizes.at(i));
+        in.seekg(offsets[i]);
+        if (!in.read(&packed[0], packed.size())) {
+            throw std::runtime_error("truncated block");
+        }
+    }
+
+    // 解压一块压缩数据，可在多个线程中同时调用
+    void decode(size_t i, std::string const &packed,
+                std::string &plain) const {
+        plain.resize(block_length(i));
+        tree.decode(reinterpret_cast<unsigned char const *>(packed.data()),
+                    packed.size(), &plain[0], plain.size());
+    }
+
+    // 随机访问：单独解压第 i 块
+    std::string read_block(size_t i) {
+        std::string packed;
+        std::string plain;
+        load(i, packed);
+        decode(i, packed, plain);
+        return plain;
+    }
+
+    // 按批读入压缩块，在线程池中并行解码后顺序写出
+    void decompress(ThreadPool &pool, std::string const &output_file) {
+        std::ofstream out(output_file, std::ios::binary);
+        size_t batch = pool.size() * 4;
+        ArrayList<std::string> packed(batch, std::string());
+        ArrayList<std::string> plain(batch, std::string());
+        for (size_t first = 0; first < block_count(); first += batch) {
+            size_t n = std::min(batch, block_count() - first);
+            for (size_t i = 0; i < n; i++) {
+                load(first + i, packed[i]);
+            }
+            pool.run(n, [&](size_t i) {
+                decode(first + i, packed[i], plain[i]);
+            });
+            for (size_t i = 0; i < n; i++) {
+                out.write(plain[i].data(), plain[i].size());
+            }
+        }
+        if (!out) {
+            throw std::runtime_error("failed to write " + output_file);
+        }
+    }
+
+private:
+    std::ifstream in;
+    HuffmanTree tree;
+    uint32_t block_size;
+    uint64_t total;
+    ArrayList<uint64_t> offsets;
+    ArrayList<uint32_t> sizes;
+};
+
+#endif // !HUFF_BLOCK_H
@@ -0,0 +1,391 @@
+#ifndef HUFF_STREAM_H
+#define HUFF_STREAM_H
+
+#include "../MyDS/arraylist.h"
+#include "blockingqueue.h"
+#include "histogram.h"
+#include "huffblock.h"
+#include "hufftree.h"
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+// 流式格式（多字节整数均为小端序）：
+//   "HFS1"，之后是若干帧，每帧以 1 字节类型开头
+//   FRAME_TABLE  u32 原文长度 | 256 字节码长表 | u32 压缩长度 | 数据
+//   FRAME_REUSE  u32 原文长度 | u32 压缩长度 | 数据，沿用上一张码表
+//   FRAME_END    流结束
+// 码表随帧给出，因此不需要预先知道输入长度，也不需要读两遍输入
+namespace huffstream {
+
+enum FrameType : unsigned char {
+    FRAME_END = 0,
+    FRAME_TABLE = 1,
+    FRAME_REUSE = 2,
+};
+
+constexpr size_t DEFAULT_BLOCK_SIZE = 1 << 20;
+constexpr size_t DEFAULT_MEMORY_BUDGET = 16 << 20;
+constexpr size_t DEFAULT_ADAPTIVE_INTERVAL = 64 << 10;
+
+// 一张码表在帧中占用的位数
+constexpr size_t TABLE_BITS = 256 * 8;
+
+struct Options {
+    size_t memory_budget = DEFAULT_MEMORY_BUDGET;
+    size_t max_length = 0;
+    // 自适应模式：每 adaptive_interval 字节重新估计一次频率，
+    // 只有新码表省下的位数超过码表本身的开销时才换表
+    bool adaptive = false;
+    size_t adaptive_interval = DEFAULT_ADAPTIVE_INTERVAL;
+};
+
+} // namespace huffstream
+
+// 流式编码器：feed 累积到一整块后立即编码成帧交给 sink，
+// 占用内存约为两块大小，与输入总长度无关。
+// adaptive 为真时每块都重新估计频率，并与沿用上一张码表的代价比较
+class HuffmanEncoder {
+public:
+    // sink 可以与参数交换内容，以便复用缓冲区
+    using Sink = std::function<void(std::string &)>;
+
+    explicit HuffmanEncoder(
+        Sink sink, size_t block_size = huffstream::DEFAULT_BLOCK_SIZE,
+        size_t max_length = 0, bool adaptive = false)
+        : sink(std::move(sink)),
+          block_size(block_size),
+          max_length(max_length),
+          adaptive(adaptive),
+          started(false),
+          finished(false),
+          has_table(false),
+          active(0),
+          blocks(0),
+          tables(0) {
+        if (block_size == 0 || block_size > UINT32_MAX) {
+            throw std::invalid_argument("invalid block size");
+        }
+        pending.reserve(block_size);
+    }
+
+    HuffmanEncoder(HuffmanEncoder const &) = delete;
+    HuffmanEncoder &operator=(HuffmanEncoder const &) = delete;
+
+    void feed(char const *data, size_t size) {
+        if (finished) {
+            throw std::logic_error("feed after finish");
+        }
+        while (size > 0) {
+            // 缓冲区为空且输入足够一整块时直接编码，省去一次拷贝
+            if (pending.empty() && size >= block_size) {
+                encode_block(data, block_size);
+                data += block_size;
+                size -= block_size;
+                continue;
+            }
+            size_t n = std::min(size, block_size - pending.size());
+            pending.append(data, n);
+            data += n;
+            size -= n;
+            if (pending.size() == block_size) {
+                encode_block(pending.data(), pending.size());
+                pending.clear();
+            }
+        }
+    }
+
+    // 编码剩余数据并写出结束帧
+    void finish() {
+        if (finished) {
+            return;
+        }
+        if (!pending.empty()) {
+            encode_block(pending.data(), pending.size());
+            pending.clear();
+        }
+        frame.clear();
+        start_frame();
+        frame += static_cast<char>(huffstream::FRAME_END);
+        sink(frame);
+        finished = true;
+    }
+
+    // 已写出的数据帧数
+    size_t block_count() const noexcept {
+        return blocks;
+    }
+
+    // 其中携带新码表的帧数
+    size_t table_count() const noexcept {
+        return tables;
+    }
+
+private:
+    Sink sink;
+    size_t block_size;
+    size_t max_length;
+    bool adaptive;
+    bool started;
+    bool finished;
+    bool has_table;
+    size_t active;
+    size_t blocks;
+    size_t tables;
+    std::string pending;
+    std::string frame;
+    // trees[active] 是当前码表，另一棵用于构造候选码表
+    HuffmanTree trees[2];
+
+    void start_frame() {
+        if (!started) {
+            frame += "HFS1";
+            started = true;
+        }
+    }
+
+    void encode_block(char const *data, size_t size) {
+        using namespace huffblock;
+        auto bytes = reinterpret_cast<unsigned char const *>(data);
+        size_t freq[256] = {};
+        histogram(bytes, size, freq);
+        HuffmanTree &candidate = trees[1 - active];
+        candidate.build(freq, max_length);
+        size_t bits = candidate.encoded_size();
+        bool reuse = false;
+        if (adaptive && has_table) {
+            size_t cost = reuse_cost(trees[active], freq);
+            if (cost <= bits + huffstream::TABLE_BITS) {
+                reuse = true;
+                bits = cost;
+            }
+        }
+        if (!reuse) {
+            active = 1 - active;
+            has_table = true;
+            tables++;
+        }
+        blocks++;
+        HuffmanTree const &tree = trees[active];
+
+        frame.clear();
+        start_frame();
+        frame += static_cast<char>(reuse ? huffstream::FRAME_REUSE
+                                         : huffstream::FRAME_TABLE);
+        put_u32(frame, static_cast<uint32_t>(size));
+        if (!reuse) {
+            uint8_t lengths[256];
+            tree.store_lengths(lengths);
+            frame.append(reinterpret_cast<char const *>(lengths), 256);
+        }
+        // 编码后的长度事先已知，直接编码到帧中预留的位置，不经过中间缓冲区
+        size_t packed = (bits + 7) / 8;
+        put_u32(frame, static_cast<uint32_t>(packed));
+        size_t data_at = frame.size();
+        frame.resize(data_at + packed);
+        BitWriter writer(reinterpret_cast<unsigned char *>(&frame[data_at]));
+        tree.encode(bytes, size, writer);
+        writer.finish();
+        sink(frame);
+    }
+
+    // 用已有码表编码这些频率需要的位数；有符号不在码表中时无法沿用
+    static size_t reuse_cost(HuffmanTree const &tree, size_t const *freq) {
+        size_t bits = 0;
+        for (size_t ch = 0; ch < 256; ch++) {
+            if (freq[ch] == 0) {
+                continue;
+            }
+            size_t length = tree.code(static_cast<unsigned char>(ch)).length;
+            if (length == 0) {
+                return SIZE_MAX;
+            }
+            bits += freq[ch] * length;
+        }
+        return bits;
+    }
+};
+
+// 流式解码器：逐帧读取，内存占用不超过一帧
+class HuffmanDecoder {
+public:
+    using Sink = std::function<void(char const *, size_t)>;
+
+    explicit HuffmanDecoder(Sink sink)
+        : sink(std::move(sink)),
+          has_table(false) {}
+
+    void decode(std::istream &in) {
+        using namespace huffblock;
+        char magic[4];
+        if (!in.read(magic, 4) || std::memcmp(magic, "HFS1", 4) != 0) {
+            throw std::runtime_error("not a huffman stream");
+        }
+        while (true) {
+            char type;
+            if (!in.get(type)) {
+                throw std::runtime_error("truncated huffman stream");
+            }
+            if (type == huffstream::FRAME_END) {
+                return;
+            }
+            if (type != huffstream::FRAME_TABLE &&
+                type != huffstream::FRAME_REUSE) {
+                throw std::runtime_error("unknown frame type");
+            }
+            char header[4 + 256 + 4];
+            size_t header_size = type == huffstream::FRAME_TABLE ? 4 + 256 + 4
+                                                                 : 4 + 4;
+            if (!in.read(header, header_size)) {
+                throw std::runtime_error("truncated huffman stream");
+            }
+            size_t size = get_u32(header);
+            if (type == huffstream::FRAME_TABLE) {
+                tree.load_lengths(reinterpret_cast<uint8_t *>(header + 4));
+                has_table = true;
+            } else if (!has_table) {
+                throw std::runtime_error("frame reuses a missing table");
+            }
+            packed.resize(get_u32(header + header_size - 4));
+            if (!in.read(&packed[0], packed.size())) {
+                throw std::runtime_error("truncated huffman stream");
+            }
+            plain.resize(size);
+            tree.decode(reinterpret_cast<unsigned char const *>(packed.data()),
+                        packed.size(), &plain[0], size);
+            sink(plain.data(), plain.size());
+        }
+    }
+
+private:
+    Sink sink;
+    bool has_table;
+    HuffmanTree tree;
+    std::string packed;
+    std::string plain;
+};
+
+namespace huffstream {
+
+// 三线程流水线：读线程、编码（调用者线程）、写线程通过有界队列衔接，
+// 缓冲区循环使用，总内存约为 memory_budget，可用于长度未知的管道输入
+inline void compress(std::istream &in, std::ostream &out,
+                     Options const &options = Options()) {
+    // 4 个读缓冲区各半块，编码器内 2 块，2 个帧缓冲区各约 1 块；
+    // 自适应模式下块大小即重新估计频率的间隔
+    constexpr size_t READ_SLOTS = 4;
+    constexpr size_t FRAME_SLOTS = 2;
+    size_t block_size =
+        std::max<size_t>(options.memory_budget / 8, 64 << 10);
+    if (options.adaptive) {
+        block_size = std::min(block_size, options.adaptive_interval);
+    }
+    size_t chunk_size = std::max<size_t>(block_size / 2, 64 << 10);
+
+    ArrayList<std::string> chunks(READ_SLOTS, std::string());
+    ArrayList<std::string> frames(FRAME_SLOTS, std::string());
+    BlockingQueue<std::string *> chunk_free(READ_SLOTS);
+    BlockingQueue<std::string *> chunk_full(READ_SLOTS);
+    BlockingQueue<std::string *> frame_free(FRAME_SLOTS);
+    BlockingQueue<std::string *> frame_full(FRAME_SLOTS);
+    for (auto &chunk: chunks) {
+        chunk.reserve(chunk_size);
+        chunk_free.push(&chunk);
+    }
+    for (auto &frame: frames) {
+        frame_free.push(&frame);
+    }
+
+    std::exception_ptr read_error;
+    std::exception_ptr write_error;
+    std::exception_ptr encode_error;
+
+    std::thread reader([&] {
+        try {
+            std::string *chunk;
+            while (chunk_free.pop(chunk)) {
+                chunk->resize(chunk_size);
+                in.read(&(*chunk)[0], chunk_size);
+                chunk->resize(in.gcount());
+                if (chunk->empty() || !chunk_full.push(chunk)) {
+                    break;
+                }
+            }
+            if (in.bad()) {
+                throw std::runtime_error("failed to read input");
+            }
+        } catch (...) {
+            read_error = std::current_exception();
+        }
+        chunk_full.close();
+    });
+
+    std::thread writer([&] {
+        try {
+            std::string *frame;
+            while (frame_full.pop(frame)) {
+                if (!out.write(frame->data(), frame->size())) {
+                    throw std::runtime_error("failed to write output");
+                }
+                frame_free.push(frame);
+            }
+            out.flush();
+        } catch (...) {
+            write_error = std::current_exception();
+        }
+        frame_free.close();
+    });
+
+    try {
+        HuffmanEncoder encoder(
+            [&](std::string &frame) {
+                std::string *slot;
+                if (!frame_free.pop(slot)) {
+                    throw std::runtime_error("writer stopped");
+                }
+                slot->swap(frame);
+                frame_full.push(slot);
+            },
+            block_size, options.max_length, options.adaptive);
+        std::string *chunk;
+        while (chunk_full.pop(chunk)) {
+            encoder.feed(chunk->data(), chunk->size());
+            chunk_free.push(chunk);
+        }
+        if (!read_error) {
+            encoder.finish();
+        }
+    } catch (...) {
+        encode_error = std::current_exception();
+    }
+    chunk_free.close();
+    frame_full.close();
+    reader.join();
+    writer.join();
+
+    for (auto const &error: {read_error, write_error, encode_error}) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+inline void decompress(std::istream &in, std::ostream &out) {
+    HuffmanDecoder decoder([&](char const *data, size_t size) {
+        if (!out.write(data, size)) {
+            throw std::runtime_error("failed to write output");
+        }
+    });
+    decoder.decode(in);
+    out.flush();
+}
+
+} // namespace huffstream
+
+#endif // !HUFF_STREAM_H
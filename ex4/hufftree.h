@@ -0,0 +1,598 @@
+#ifndef HUFF_TREE_H
+#define HUFF_TREE_H
+
+#include "../MyDS/arraylist.h"
+#include "../MyDS/arraystack.h"
+#include "../MyDS/heap.h"
+#include "../MyDS/pair.h"
+#include "histogram.h"
+#include "mappedfile.h"
+#include "threadpool.h"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+// 位写入器：码字先移入 64 位累加器，凑满 32 位后整字写入大缓冲区，
+// 缓冲区满时才写出一次。输出目标可以是 ostream、内存中的 string，
+// 也可以是调用者提供的足够大的内存（例如映射的输出文件），此时直接写入。
+// 缓冲区默认 1 MiB；输出量较小时可以用 capacity 指定更小的缓冲区
+class BitWriter {
+public:
+    explicit BitWriter(std::ostream &out)
+        : BitWriter(&out, nullptr, BUFFER_SIZE) {}
+
+    explicit BitWriter(std::string &sink, size_t capacity = BUFFER_SIZE)
+        : BitWriter(nullptr, &sink, capacity) {}
+
+    explicit BitWriter(unsigned char *dest)
+        : out(nullptr),
+          sink(nullptr),
+          buffer(dest),
+          limit(SIZE_MAX),
+          pos(0),
+          flushed(0),
+          acc(0),
+          count(0) {}
+
+    BitWriter(BitWriter const &) = delete;
+    BitWriter &operator=(BitWriter const &) = delete;
+
+    ~BitWriter() {
+        if (limit != SIZE_MAX) {
+            delete[] buffer;
+        }
+    }
+
+    // length 取 1~32，bits 的高位先输出
+    void put(uint32_t bits, unsigned length) {
+        acc = (acc << length) | bits;
+        count += length;
+        if (count >= 32) {
+            count -= 32;
+            uint32_t word = static_cast<uint32_t>(acc >> count);
+            buffer[pos] = static_cast<unsigned char>(word >> 24);
+            buffer[pos + 1] = static_cast<unsigned char>(word >> 16);
+            buffer[pos + 2] = static_cast<unsigned char>(word >> 8);
+            buffer[pos + 3] = static_cast<unsigned char>(word);
+            pos += 4;
+            if (pos == limit) {
+                flush_buffer();
+            }
+        }
+    }
+
+    // 写出剩余的位，最后一个字节低位补 0
+    void finish() {
+        while (count >= 8) {
+            count -= 8;
+            buffer[pos++] = static_cast<unsigned char>(acc >> count);
+        }
+        if (count > 0) {
+            buffer[pos++] = static_cast<unsigned char>(acc << (8 - count));
+            count = 0;
+        }
+        flush_buffer();
+    }
+
+    // 已写出的总字节数
+    size_t written() const noexcept {
+        return flushed + pos;
+    }
+
+private:
+    static constexpr size_t BUFFER_SIZE = 1 << 20;
+
+    std::ostream *out;
+    std::string *sink;
+    unsigned char *buffer;
+    size_t limit;
+    size_t pos;
+    size_t flushed;
+    uint64_t acc;
+    unsigned count;
+
+    // 缓冲区按整字写入，长度取 4 的倍数，至少一个字，至多 BUFFER_SIZE
+    BitWriter(std::ostream *out, std::string *sink, size_t capacity)
+        : out(out),
+          sink(sink),
+          buffer(nullptr),
+          limit(std::min(BUFFER_SIZE, std::max<size_t>(capacity, 4) / 4 * 4)),
+          pos(0),
+          flushed(0),
+          acc(0),
+          count(0) {
+        buffer = new unsigned char[limit];
+    }
+
+    void flush_buffer() {
+        if (out != nullptr) {
+            out->write(reinterpret_cast<char const *>(buffer), pos);
+        } else if (sink != nullptr) {
+            sink->append(reinterpret_cast<char const *>(buffer), pos);
+        } else {
+            return;
+        }
+        flushed += pos;
+        pos = 0;
+    }
+};
+
+class HuffmanTree {
+public:
+    // 结点存放在定长数组中，子结点用 16 位下标表示，整棵树只占几 KB，
+    // 解码时上层结点都在同一两条缓存行内。child[0]、child[1] 分别是
+    // 位 0、位 1 对应的子结点，解码时直接按位取下标，不需要分支。
+    // 解码树以 0 号为根，根不会是任何结点的子结点，因此下标 0 也表示
+    // 没有该子结点；范式码总是先占用 0 分支，child[0] 为 0 即是叶子
+    struct Node {
+        uint16_t child[2];
+        unsigned char data;
+    };
+
+    // 256 个叶子的满二叉树共 511 个结点
+    static constexpr size_t MAX_NODES = 2 * 256 - 1;
+
+    // 码字表项：bits 的低 length 位为码字
+    struct Code {
+        uint32_t bits;
+        uint8_t length;
+    };
+
+    // 码字表宽度，不指定 max_length 时也以此为上限
+    static constexpr size_t MAX_CODE_LENGTH = 32;
+
+    HuffmanTree()
+        : node_count(0),
+          total(0),
+          bits_unlimited(0),
+          bits_encoded(0) {}
+
+    HuffmanTree(HuffmanTree const &) = delete;
+    HuffmanTree &operator=(HuffmanTree const &) = delete;
+
+    // max_length 为 0 时码长只受 MAX_CODE_LENGTH 限制；码长超出限制时
+    // 改用 package-merge 求长度受限的最优码长。最终统一分配范式码字
+    void build_tree(std::string const &filename, size_t max_length = 0) {
+        size_t freq[256] = {};
+        count_freq(filename, freq);
+        build(freq, max_length);
+    }
+
+    // 与 build_tree 相同，但通过内存映射读取输入；
+    // 给出线程池时大文件的频率统计分给多个线程
+    void build_tree_mapped(std::string const &filename, size_t max_length = 0,
+                           ThreadPool *pool = nullptr) {
+        MappedFile in(filename);
+        size_t freq[256] = {};
+        histogram(in.data(), in.size(), freq, pool);
+        build(freq, max_length);
+    }
+
+    // 由 256 项的频率表建树。哈夫曼树直接建在结点数组中：
+    // 前 n 个是叶子，之后依次是合并出的内部结点，堆中只存下标
+    void build(size_t const *freq, size_t max_length = 0) {
+        size_t weight[MAX_NODES];
+        ArrayList<uint16_t> leaves(256);
+        total = 0;
+        for (size_t ch = 0; ch < 256; ch++) {
+            if (freq[ch] > 0) {
+                uint16_t index = static_cast<uint16_t>(leaves.size());
+                nodes[index] = Node{{0, 0}, static_cast<unsigned char>(ch)};
+                weight[index] = freq[ch];
+                leaves.push_back(index);
+                total += freq[ch];
+            }
+        }
+
+        // 空输入没有任何符号，不建树，编码结果也为空
+        if (leaves.empty()) {
+            node_count = 0;
+            for (auto &code: table) {
+                code = Code{0, 0};
+            }
+            bits_unlimited = bits_encoded = 0;
+            return;
+        }
+
+        auto comp = [&weight](uint16_t a, uint16_t b) {
+            return weight[a] < weight[b];
+        };
+        Heap<uint16_t, decltype(comp)> heap(leaves, comp);
+        size_t n = leaves.size();
+        size_t next = n;
+        while (heap.size() > 1) {
+            uint16_t left = heap.top();
+            heap.pop();
+            uint16_t right = heap.top();
+            heap.pop();
+            nodes[next] = Node{{left, right}, 0};
+            weight[next] = weight[left] + weight[right];
+            heap.push(static_cast<uint16_t>(next++));
+        }
+
+        size_t lengths[256] = {};
+        size_t longest = collect_lengths(heap.top(), n, 0, lengths);
+        bits_unlimited = encoded_bits(freq, lengths);
+
+        size_t limit = max_length == 0 ? MAX_CODE_LENGTH
+                                       : std::min(max_length, MAX_CODE_LENGTH);
+        if (longest > limit) {
+            limit_length(freq, limit, lengths);
+        }
+        assign_codes(lengths);
+        bits_encoded = encoded_bits(freq, lengths);
+    }
+
+    // 由码长表恢复范式码字和解码树，用于解码已保存的码表
+    void load_lengths(uint8_t const *lengths) {
+        size_t wide[256];
+        for (size_t ch = 0; ch < 256; ch++) {
+            wide[ch] = lengths[ch];
+            if (lengths[ch] > MAX_CODE_LENGTH) {
+                throw std::runtime_error("corrupt code length table");
+            }
+        }
+        assign_codes(wide);
+        total = 0;
+        bits_unlimited = bits_encoded = 0;
+    }
+
+    void store_lengths(uint8_t *lengths) const {
+        for (size_t ch = 0; ch < 256; ch++) {
+            lengths[ch] = table[ch].length;
+        }
+    }
+
+    Code const &code(unsigned char ch) const {
+        return table[ch];
+    }
+
+    void encode(unsigned char const *data, size_t size,
+                BitWriter &writer) const {
+        for (size_t i = 0; i < size; i++) {
+            Code const &code = table[data[i]];
+            writer.put(code.bits, code.length);
+        }
+    }
+
+    // 解码恰好 count 个符号写入 out，返回消耗的输入字节数
+    size_t decode(unsigned char const *data, size_t size, char *out,
+                  size_t count) const {
+        size_t node = 0;
+        size_t k = 0;
+        for (size_t produced = 0; produced < count; k++) {
+            if (k == size) {
+                throw std::runtime_error("truncated huffman stream");
+            }
+            for (int i = 7; i >= 0; i--) {
+                node = step(node, (data[k] >> i) & 1);
+                if (is_leaf(node)) {
+                    out[produced] = static_cast<char>(nodes[node].data);
+                    node = 0;
+                    if (++produced == count) {
+                        break;
+                    }
+                }
+            }
+        }
+        return k;
+    }
+
+    // 编码后的总位数（不含填充）
+    size_t encoded_size() const {
+        return bits_encoded;
+    }
+
+    // 不限制码长时的总位数
+    size_t unlimited_size() const {
+        return bits_unlimited;
+    }
+
+    // 限制码长带来的压缩率损失（相对于不受限编码的比例）
+    double limit_cost() const {
+        if (bits_unlimited == 0) {
+            return 0;
+        }
+        return static_cast<double>(bits_encoded - bits_unlimited) /
+               bits_unlimited;
+    }
+
+    size_t max_code_length() const {
+        size_t len = 0;
+        for (auto const &code: table) {
+            len = std::max(len, static_cast<size_t>(code.length));
+        }
+        return len;
+    }
+
+    void save_codes(std::string const &filename) {
+        std::ofstream file(filename, std::ios::binary);
+        for (size_t ch = 0; ch < 256; ch++) {
+            Code const &code = table[ch];
+            if (code.length == 0) {
+                continue;
+            }
+            file << static_cast<unsigned char>(ch) << ":";
+            for (size_t i = code.length; i > 0; i--) {
+                file << ((code.bits >> (i - 1)) & 1);
+            }
+            file << '\n';
+        }
+        file.close();
+    }
+
+    void compress(std::string const &input_file,
+                  std::string const &output_file) {
+        std::ifstream in(input_file, std::ios::binary);
+        std::ofstream out(output_file, std::ios::binary);
+        BitWriter writer(out);
+
+        std::string buf(READ_SIZE, '\0');
+        while (in) {
+            in.read(&buf[0], READ_SIZE);
+            encode(reinterpret_cast<unsigned char const *>(buf.data()),
+                   in.gcount(), writer);
+        }
+        writer.finish();
+        in.close();
+        out.close();
+    }
+
+    // 输入、输出都使用内存映射：直接从映射的输入编码到映射的输出，
+    // 输出按最长码长预留空间，完成后截断到实际长度
+    void compress_mapped(std::string const &input_file,
+                         std::string const &output_file) {
+        MappedFile in(input_file);
+        MappedOutput out(output_file,
+                         (in.size() * max_code_length() + 7) / 8 + 8);
+        BitWriter writer(out.data());
+        encode(in.data(), in.size(), writer);
+        writer.finish();
+        out.close(writer.written());
+    }
+
+    void decompress_mapped(std::string const &input_file,
+                           std::string const &output_file) {
+        MappedFile in(input_file);
+        MappedOutput out(output_file, total);
+        if (total > 0) {
+            decode(in.data(), in.size(), reinterpret_cast<char *>(out.data()),
+                   total);
+        }
+        out.close(total);
+    }
+
+    // 建树时记录的原文长度用于忽略最后一个字节中的填充位
+    void decompress(std::string const &input_file,
+                    std::string const &output_file) {
+        std::ifstream in(input_file, std::ios::binary);
+        std::ofstream out(output_file, std::ios::binary);
+        size_t remaining = total;
+        size_t node = 0;
+        std::string buf(READ_SIZE, '\0');
+        std::string decoded;
+        while (remaining > 0 && in) {
+            in.read(&buf[0], READ_SIZE);
+            size_t n = in.gcount();
+            for (size_t k = 0; k < n && remaining > 0; k++) {
+                for (int i = 7; i >= 0; i--) {
+                    node = step(node, (buf[k] >> i) & 1);
+                    if (is_leaf(node)) {
+                        decoded += static_cast<char>(nodes[node].data);
+                        node = 0;
+                        if (--remaining == 0) {
+                            break;
+                        }
+                    }
+                }
+            }
+            out.write(decoded.data(), decoded.size());
+            decoded.clear();
+        }
+        in.close();
+        out.close();
+    }
+
+private:
+    static constexpr size_t READ_SIZE = 1 << 16;
+
+    Node nodes[MAX_NODES] = {};
+    size_t node_count;
+    // 原文长度，即所有符号频率之和
+    size_t total;
+    size_t bits_unlimited;
+    size_t bits_encoded;
+
+    Code table[256] = {};
+
+    // package-merge 中的元素：叶子或由两个元素合并成的包
+    struct Item {
+        size_t weight;
+        int leaf;
+        size_t left;
+        size_t right;
+    };
+
+    void count_freq(std::string const &filename, size_t *freq) {
+        std::ifstream file(filename, std::ios::binary);
+        std::string buf(READ_SIZE, '\0');
+        while (file) {
+            file.read(&buf[0], READ_SIZE);
+            histogram(reinterpret_cast<unsigned char const *>(buf.data()),
+                      file.gcount(), freq);
+        }
+        file.close();
+    }
+
+    bool is_leaf(size_t node) const {
+        return nodes[node].child[0] == 0;
+    }
+
+    // 沿解码树走一步，走到不存在的子结点说明码字无效
+    size_t step(size_t node, unsigned bit) const {
+        size_t next = nodes[node].child[bit];
+        if (next == 0) {
+            invalid_code();
+        }
+        return next;
+    }
+
+    [[noreturn]] static void invalid_code() {
+        throw std::runtime_error("invalid huffman code");
+    }
+
+    // 在 build 建出的树中记录每个叶子的深度作为码长，返回最大码长。
+    // 下标小于 leaves 的结点是叶子；只有一个符号时根即叶子，码长记为 1
+    size_t collect_lengths(size_t node, size_t leaves, size_t depth,
+                           size_t *lengths) const {
+        if (node < leaves) {
+            lengths[nodes[node].data] = std::max(depth, size_t(1));
+            return lengths[nodes[node].data];
+        }
+        return std::max(
+            collect_lengths(nodes[node].child[0], leaves, depth + 1, lengths),
+            collect_lengths(nodes[node].child[1], leaves, depth + 1, lengths));
+    }
+
+    static size_t encoded_bits(size_t const *freq, size_t const *lengths) {
+        size_t bits = 0;
+        for (size_t ch = 0; ch < 256; ch++) {
+            bits += freq[ch] * lengths[ch];
+        }
+        return bits;
+    }
+
+    // package-merge：leaves 按频率升序排列，返回每个叶子的码长
+    static ArrayList<size_t>
+    package_merge(ArrayList<Pair<size_t, unsigned char>> const &leaves,
+                  size_t limit) {
+        size_t n = leaves.size();
+        ArrayList<size_t> lengths(n, 0);
+        if (n == 1) {
+            lengths[0] = 1;
+            return lengths;
+        }
+
+        ArrayList<Item> pool(n * (limit + 1));
+        ArrayList<size_t> list(2 * n);
+        for (size_t i = 0; i < n; i++) {
+            pool.push_back(Item{leaves[i].first, static_cast<int>(i), 0, 0});
+            list.push_back(i);
+        }
+
+        // 每一轮把上一层的元素两两打包，再与叶子按权重归并
+        for (size_t level = 1; level < limit; level++) {
+            ArrayList<size_t> merged(2 * n);
+            size_t i = 0;
+            size_t j = 0;
+            while (i < n || j + 1 < list.size()) {
+                size_t package_weight = 0;
+                if (j + 1 < list.size()) {
+                    package_weight =
+                        pool[list[j]].weight + pool[list[j + 1]].weight;
+                }
+                if (j + 1 >= list.size() ||
+                    (i < n && pool[i].weight <= package_weight)) {
+                    merged.push_back(i++);
+                } else {
+                    pool.push_back(Item{package_weight, -1, list[j],
+                                        list[j + 1]});
+                    merged.push_back(pool.size() - 1);
+                    j += 2;
+                }
+            }
+            list = std::move(merged);
+        }
+
+        // 取前 2n-2 个元素，每个叶子出现的次数即其码长
+        ArrayStack<size_t> stack;
+        for (size_t k = 0; k < 2 * n - 2; k++) {
+            stack.push(list[k]);
+            while (!stack.empty()) {
+                Item const &item = pool[stack.top()];
+                stack.pop();
+                if (item.leaf >= 0) {
+                    lengths[item.leaf]++;
+                } else {
+                    stack.push(item.left);
+                    stack.push(item.right);
+                }
+            }
+        }
+        return lengths;
+    }
+
+    static void limit_length(size_t const *freq, size_t limit,
+                             size_t *lengths) {
+        ArrayList<Pair<size_t, unsigned char>> leaves;
+        for (size_t ch = 0; ch < 256; ch++) {
+            if (freq[ch] > 0) {
+                leaves.push_back(
+                    Pair(freq[ch], static_cast<unsigned char>(ch)));
+            }
+        }
+        if ((size_t(1) << limit) < leaves.size()) {
+            throw std::invalid_argument("max code length out of range");
+        }
+        std::sort(leaves.begin(), leaves.end());
+        ArrayList<size_t> limited = package_merge(leaves, limit);
+        for (size_t i = 0; i < leaves.size(); i++) {
+            lengths[leaves[i].second] = limited[i];
+        }
+    }
+
+    // 按 (码长, 符号) 顺序分配范式码字，并据此在结点数组中重建解码树；
+    // 码长为 0 的符号不参与编码
+    void assign_codes(size_t const *lengths) {
+        ArrayList<Pair<size_t, unsigned char>> symbols;
+        for (size_t ch = 0; ch < 256; ch++) {
+            if (lengths[ch] > 0) {
+                symbols.push_back(
+                    Pair(lengths[ch], static_cast<unsigned char>(ch)));
+            }
+        }
+        std::sort(symbols.begin(), symbols.end());
+
+        nodes[0] = Node{{0, 0}, 0};
+        node_count = 1;
+        for (auto &code: table) {
+            code = Code{0, 0};
+        }
+        uint64_t code = 0;
+        size_t prev_length = symbols.empty() ? 0 : symbols[0].first;
+        for (auto const &symbol: symbols) {
+            code <<= symbol.first - prev_length;
+            prev_length = symbol.first;
+            if (code >> symbol.first) {
+                throw std::runtime_error("code lengths oversubscribed");
+            }
+            table[symbol.second] = Code{static_cast<uint32_t>(code),
+                                        static_cast<uint8_t>(symbol.first)};
+            insert_code(symbol.second);
+            code++;
+        }
+    }
+
+    // 完整的前缀码最多 511 个结点；只有读入残缺的码长表时才可能超出
+    void insert_code(unsigned char data) {
+        Code const &code = table[data];
+        size_t node = 0;
+        for (size_t i = code.length; i > 0; i--) {
+            uint16_t &next = nodes[node].child[(code.bits >> (i - 1)) & 1];
+            if (next == 0) {
+                if (node_count == MAX_NODES) {
+                    throw std::runtime_error("corrupt code length table");
+                }
+                nodes[node_count] = Node{{0, 0}, 0};
+                next = static_cast<uint16_t>(node_count++);
+            }
+            node = next;
+        }
+        nodes[node].data = data;
+    }
+};
+
+#endif // !HUFF_TREE_H
@@ -0,0 +1,139 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// 只读内存映射文件；sequential 为真时用 madvise 提示内核顺序预读
+class MappedFile {
+public:
+    explicit MappedFile(std::string const &filename, bool sequential = true)
+        : bytes(nullptr),
+          length(0) {
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("cannot open " + filename + ": " +
+                                     std::strerror(errno));
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("cannot stat " + filename);
+        }
+        length = static_cast<size_t>(st.st_size);
+        // 长度为 0 的文件不能映射，按空数据处理
+        if (length > 0) {
+            void *p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("cannot map " + filename + ": " +
+                                         std::strerror(errno));
+            }
+            bytes = static_cast<unsigned char const *>(p);
+            if (sequential) {
+                ::madvise(p, length, MADV_SEQUENTIAL);
+            }
+        }
+        ::close(fd);
+    }
+
+    MappedFile(MappedFile const &) = delete;
+    MappedFile &operator=(MappedFile const &) = delete;
+
+    ~MappedFile() {
+        if (bytes != nullptr) {
+            ::munmap(const_cast<unsigned char *>(bytes), length);
+        }
+    }
+
+    unsigned char const *data() const noexcept {
+        return bytes;
+    }
+
+    size_t size() const noexcept {
+        return length;
+    }
+
+private:
+    unsigned char const *bytes;
+    size_t length;
+};
+
+// 可写内存映射输出：先把文件扩展到 capacity（稀疏文件，不占实际空间），
+// 写完后 close(n) 截断到实际长度
+class MappedOutput {
+public:
+    MappedOutput(std::string const &filename, size_t capacity)
+        : bytes(nullptr),
+          length(capacity),
+          fd(::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)) {
+        if (fd < 0) {
+            throw std::runtime_error("cannot open " + filename + ": " +
+                                     std::strerror(errno));
+        }
+        if (::ftruncate(fd, static_cast<off_t>(length)) != 0) {
+            ::close(fd);
+            throw std::runtime_error("cannot resize " + filename);
+        }
+        if (length > 0) {
+            void *p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                             MAP_SHARED, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("cannot map " + filename + ": " +
+                                         std::strerror(errno));
+            }
+            bytes = static_cast<unsigned char *>(p);
+        }
+    }
+
+    MappedOutput(MappedOutput const &) = delete;
+    MappedOutput &operator=(MappedOutput const &) = delete;
+
+    ~MappedOutput() {
+        unmap();
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    unsigned char *data() noexcept {
+        return bytes;
+    }
+
+    size_t capacity() const noexcept {
+        return length;
+    }
+
+    // 解除映射并把文件截断为 size 字节
+    void close(size_t size) {
+        unmap();
+        int result = ::ftruncate(fd, static_cast<off_t>(size));
+        ::close(fd);
+        fd = -1;
+        if (result != 0) {
+            throw std::runtime_error("cannot truncate output");
+        }
+    }
+
+private:
+    unsigned char *bytes;
+    size_t length;
+    int fd;
+
+    void unmap() {
+        if (bytes != nullptr) {
+            ::munmap(bytes, length);
+            bytes = nullptr;
+        }
+    }
+};
+
+#endif // !MAPPED_FILE_H
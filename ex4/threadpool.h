@@ -0,0 +1,136 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// 固定大小的线程池：run(n, task) 把下标 [0, n) 分给工作线程并等待完成
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads = default_threads())
+        : count(0),
+          task(nullptr),
+          total(0),
+          next(0),
+          busy(0),
+          generation(0),
+          stopping(false) {
+        threads = std::max(threads, size_t(1));
+        workers.reset(new std::thread[threads]);
+        count = threads;
+        // 创建某个线程失败时，让已启动的线程退出并等待它们结束再抛出
+        try {
+            for (size_t i = 0; i < threads; i++) {
+                workers[i] = std::thread([this] { work(); });
+            }
+        } catch (...) {
+            stop();
+            throw;
+        }
+    }
+
+    ThreadPool(ThreadPool const &) = delete;
+    ThreadPool &operator=(ThreadPool const &) = delete;
+
+    ~ThreadPool() {
+        stop();
+    }
+
+    size_t size() const noexcept {
+        return count;
+    }
+
+    // 阻塞直到所有下标处理完毕；任务抛出的第一个异常在此重新抛出
+    void run(size_t n, std::function<void(size_t)> const &fn) {
+        if (n == 0) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        task = &fn;
+        total = n;
+        next = 0;
+        busy = count;
+        error = nullptr;
+        generation++;
+        wake.notify_all();
+        done.wait(lock, [this] { return busy == 0; });
+        task = nullptr;
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    static size_t default_threads() {
+        return std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+private:
+    std::unique_ptr<std::thread[]> workers;
+    size_t count;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::function<void(size_t)> const *task;
+    size_t total;
+    std::atomic<size_t> next;
+    size_t busy;
+    size_t generation;
+    bool stopping;
+    std::exception_ptr error;
+
+    // 通知所有工作线程退出，并等待已启动的线程结束
+    void stop() noexcept {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (size_t i = 0; i < count; i++) {
+            if (workers[i].joinable()) {
+                workers[i].join();
+            }
+        }
+    }
+
+    void work() {
+        size_t seen = 0;
+        while (true) {
+            std::function<void(size_t)> const *fn;
+            size_t n;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock,
+                          [&] { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+                fn = task;
+                n = total;
+            }
+            for (size_t i = next++; i < n; i = next++) {
+                try {
+                    (*fn)(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busy == 0) {
+                done.notify_one();
+            }
+        }
+    }
+};
+
+#endif // !THREAD_POOL_H